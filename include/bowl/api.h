@@ -4,6 +4,10 @@
 #include "bowl.h"
 #include "module.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * A helper data structure that allows to return either a result value or an
  * exception.
@@ -26,11 +30,27 @@ typedef struct {
  * @param variable A pointer to a memory location where the popped value should be stored.
  */
 #define BOWL_STACK_POP_VALUE(stack, variable) \
-if (*(stack)->datastack == NULL) {\
-    return bowl_format_exception((stack), "stack underflow in function '%s'", __FUNCTION__).value;\
+if ((stack)->datastack->length == 0) {\
+    return bowl_lazy_exception((stack), BowlStackUnderflowTemplate, __FUNCTION__, NULL, NULL);\
+}\
+*(variable) = (stack)->datastack->elements[--(stack)->datastack->length];
+
+/**
+ * Pops the provided number of values from the datastack at once or returns an
+ * exception value if the datastack contains less values. 
+ * The values are stored in the order in which they were pushed. That is, the
+ * former top of the datastack is stored at index 'count - 1'.
+ * @param stack The current stack of the environment.
+ * @param count The number of values to pop.
+ * @param variables An array of at least 'count' elements where the popped values 
+ * should be stored.
+ */
+#define BOWL_STACK_POP_N(stack, count, variables) \
+if ((stack)->datastack->length < (u64) (count)) {\
+    return bowl_lazy_exception((stack), BowlStackUnderflowTemplate, __FUNCTION__, NULL, NULL);\
 }\
-*(variable) = (*(stack)->datastack)->list.head;\
-*(stack)->datastack = (*(stack)->datastack)->list.tail;
+(stack)->datastack->length -= (u64) (count);\
+memcpy((variables), (stack)->datastack->elements + (stack)->datastack->length, (u64) (count) * sizeof(BowlValue));
 
 /**
  * Assigns the provided 'value' to the given 'temporary' variable and checks 
@@ -82,10 +102,125 @@ if ((temporary)->failure) {\
 #define _BOWL_RESULT_VALUE_FIELD_NAME value
 
 /**
- * The name of the 'type' field for the 'BowlValue' type.
+ * Checks whether the provided value is an immediate value.
+ * @param value The value to check.
+ * @return Whether or not the value is encoded without a heap allocation.
+ */
+#if defined(BOWL_IMMEDIATE_VALUES)
+#define BOWL_IS_IMMEDIATE(value) ((u64) (uintptr_t) (value) >= BOWL_IMMEDIATE_NUMBER_OFFSET || ((uintptr_t) (value) & 0x7) != 0)
+#else
+#define BOWL_IS_IMMEDIATE(value) false
+#endif
+
+/**
+ * Checks whether the provided value resides in the heap. That is, it is neither
+ * an immediate value nor the empty list.
+ * @param value The value to check.
+ * @return Whether or not the value may be dereferenced.
+ */
+#define BOWL_IS_HEAP_VALUE(value) ((value) != NULL && !BOWL_IS_IMMEDIATE(value))
+
+/**
+ * Returns the type of the provided value.
+ * This macro must be used instead of accessing the 'type' field directly, since
+ * neither the empty list nor immediate values can be dereferenced.
+ * @param value The value whose type should be returned.
+ * @return The type of the value.
+ */
+#define BOWL_VALUE_TYPE(value) _bowl_value_type(value)
+
+/**
+ * Returns the IEEE 754 encoded value of the provided number.
+ * @param value A value of type 'number'.
+ * @return The value of the number with double precision.
+ */
+#if defined(BOWL_IMMEDIATE_VALUES)
+#define BOWL_NUMBER_VALUE(value) _bowl_immediate_number_decode(value)
+#else
+#define BOWL_NUMBER_VALUE(value) ((value)->number.value)
+#endif
+
+/**
+ * Returns the value of the provided boolean.
+ * @param value A value of type 'boolean'.
+ * @return The value of the boolean.
+ */
+#if defined(BOWL_IMMEDIATE_VALUES)
+#define BOWL_BOOLEAN_VALUE(value) ((value) == BOWL_IMMEDIATE_TRUE)
+#else
+#define BOWL_BOOLEAN_VALUE(value) ((value)->boolean.value)
+#endif
+
+#if defined(BOWL_IMMEDIATE_VALUES)
+
+/**
+ * Creates an immediate number. This macro is only available if immediate 
+ * values are supported. Use 'bowl_number' otherwise.
+ * @param value The IEEE 754 encoded value with double precision.
+ * @return The immediate number.
+ */
+#define BOWL_NUMBER(value) _bowl_immediate_number_encode(value)
+
+/**
+ * Creates an immediate boolean. This macro is only available if immediate 
+ * values are supported. Use 'bowl_boolean' otherwise.
+ * @param value The boolean value.
+ * @return The immediate boolean.
+ */
+#define BOWL_BOOLEAN(value) ((value) ? BOWL_IMMEDIATE_TRUE : BOWL_IMMEDIATE_FALSE)
+
+/**
+ * Encodes the provided number as an immediate value.
+ * @internal
+ */
+static inline BowlValue _bowl_immediate_number_encode(double value) {
+    u64 bits;
+    if (value != value) {
+        bits = UINT64_C(0x7FF8000000000000);
+    } else {
+        memcpy(&bits, &value, sizeof(bits));
+    }
+    return (BowlValue) (uintptr_t) (bits + BOWL_IMMEDIATE_NUMBER_OFFSET);
+}
+
+/**
+ * Decodes the provided immediate number.
+ * @internal
+ */
+static inline double _bowl_immediate_number_decode(BowlValue value) {
+    u64 const bits = (u64) (uintptr_t) value - BOWL_IMMEDIATE_NUMBER_OFFSET;
+    double result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+#endif
+
+/**
+ * Returns the type of the provided value.
  * @internal
  */
-#define _BOWL_VALUE_TYPE_FIELD_NAME type
+static inline BowlValueType _bowl_value_type(BowlValue value) {
+    if (value == NULL) {
+        return BowlListValue;
+    }
+#if defined(BOWL_IMMEDIATE_VALUES)
+    if ((u64) (uintptr_t) value >= BOWL_IMMEDIATE_NUMBER_OFFSET) {
+        return BowlNumberValue;
+    } else if (((uintptr_t) value & 0x7) != 0) {
+        return BowlBooleanValue;
+    }
+#endif
+    return value->type;
+}
+
+/**
+ * Returns the representation of the provided string or symbol.
+ * @param value A value of type 'string' or 'symbol'.
+ * @return The encoding of the value's codepoints.
+ * @see BowlStringEncoding
+ */
+#define BOWL_STRING_ENCODING(value) ((BowlStringEncoding) ((value)->flags & (BowlLatin1Flag | BowlUtf8Flag)))
 
 /**
  * Asserts that the given value has the provided type and throws an exception
@@ -94,20 +229,147 @@ if ((temporary)->failure) {\
  * @param type The expected type.
  */
 #define BOWL_ASSERT_TYPE(value, type) \
-if (((value) == NULL && (type) != BowlListValue) || ((value) != NULL && (value)->_BOWL_VALUE_TYPE_FIELD_NAME != (type))) {\
-    return bowl_format_exception((stack), "argument of illegal type '%s' in function '%s' (expected type '%s')", bowl_value_type(value), __FUNCTION__, bowl_type_name(type))._BOWL_RESULT_VALUE_FIELD_NAME;\
+if (BOWL_VALUE_TYPE(value) != (type)) {\
+    return bowl_lazy_exception((stack), BowlIllegalTypeTemplate, bowl_value_type(value), __FUNCTION__, bowl_type_name(type));\
 }
 
 
+/**
+ * Records a store of the provided value into the given object. 
+ * 
+ * This write barrier must be executed whenever a native function stores a 
+ * reference into a value after any other allocation took place since the 
+ * allocation of this value. Otherwise, a minor collection may not see that an
+ * object of the old generation refers to a value in the nursery. Stores into
+ * values which were allocated without any allocation in between do not need 
+ * the write barrier. This includes values which were allocated in the old 
+ * generation directly, because 'bowl_allocate' remembers them.
+ * 
+ * Both arguments may be evaluated multiple times.
+ * @param stack The current stack of the environment.
+ * @param object The value which has been modified.
+ * @param value The value which has been stored into the object.
+ */
+#define BOWL_WRITE_BARRIER(stack, object, value) \
+if (((object)->flags & (BowlTenuredFlag | BowlRememberedFlag)) == BowlTenuredFlag && BOWL_IS_HEAP_VALUE(value) && ((value)->flags & BowlTenuredFlag) == 0) {\
+    bowl_remember((stack), (object));\
+}
+
+/**
+ * The maximum number of codepoints of static strings and symbols whose hash is
+ * computed at compile time by the 'BOWL_STATIC_*' macros. Since static values 
+ * are never written to, the hash of longer static strings and symbols is 
+ * computed on each use by 'bowl_value_hash' and never stored. Such values 
+ * should therefore not be used as keys of maps. Use 'bowl_symbol_intern' or 
+ * the constant expressions of 'static.hpp', which have no length limit, 
+ * instead.
+ */
+#define BOWL_STATIC_HASH_LIMIT 64
+
+/**
+ * Computes the hash of a C string literal at compile time.
+ * @param string The C string literal, which must only contain ASCII characters.
+ * @return A constant expression which is equal to the hash of a string or symbol 
+ * with the same codepoints or '0' if the literal is longer than 'BOWL_STATIC_HASH_LIMIT'
+ * characters.
+ */
+#define BOWL_ASCII_HASH(string) _BOWL_STATIC_HASH(_BOWL_ASCII_CODEPOINT, string, sizeof(string) - 1)
+
+/**
+ * Computes the hash of a byte string literal which contains 32-bit unicode 
+ * codepoints in native byte order at compile time.
+ * @param string The byte string literal.
+ * @param length The number of codepoints.
+ * @return A constant expression which is equal to the hash of a string or symbol 
+ * with the same codepoints or '0' if there are more than 'BOWL_STATIC_HASH_LIMIT'
+ * codepoints.
+ */
+#define BOWL_UNICODE_HASH(string, length) _BOWL_STATIC_HASH(_BOWL_UNICODE_CODEPOINT, string, length)
+
+/**
+ * Computes the hash of the provided codepoints at compile time if possible.
+ * @internal
+ */
+#define _BOWL_STATIC_HASH(codepoint, string, length) \
+((u64) (length) > BOWL_STATIC_HASH_LIMIT ? 0 : _BOWL_HASH_FINISH(_BOWL_HASH_64(BOWL_HASH_OFFSET_BASIS, codepoint, string, length, 0)))
+
+/**
+ * Replaces a hash of '0' by '1'.
+ * @internal
+ */
+#define _BOWL_HASH_FINISH(hash) ((hash) == 0 ? 1 : (hash))
+
+/**
+ * Returns the codepoint at the provided index of a C string literal or '0' if 
+ * the index is out of bounds.
+ * @internal
+ */
+#define _BOWL_ASCII_CODEPOINT(string, length, index) \
+((u64) (index) < (u64) (length) ? (u32) (u8) (string)[(index)] : 0)
+
+/**
+ * Returns the codepoint at the provided index of a byte string literal which 
+ * contains 32-bit unicode codepoints or '0' if the index is out of bounds.
+ * @internal
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define _BOWL_UNICODE_CODEPOINT(string, length, index) \
+((u64) (index) < (u64) (length) ? (u32) (u8) (string)[4 * (index)] << 24 | (u32) (u8) (string)[4 * (index) + 1] << 16 | (u32) (u8) (string)[4 * (index) + 2] << 8 | (u32) (u8) (string)[4 * (index) + 3] : 0)
+#else
+#define _BOWL_UNICODE_CODEPOINT(string, length, index) \
+((u64) (index) < (u64) (length) ? (u32) (u8) (string)[4 * (index)] | (u32) (u8) (string)[4 * (index) + 1] << 8 | (u32) (u8) (string)[4 * (index) + 2] << 16 | (u32) (u8) (string)[4 * (index) + 3] << 24 : 0)
+#endif
+
+/**
+ * Combines the hash with the codepoint at the provided index if the index is
+ * in bounds. Otherwise, the hash remains unchanged.
+ * @internal
+ */
+#define _BOWL_HASH_1(hash, codepoint, string, length, index) \
+(((hash) ^ codepoint(string, length, index)) * ((u64) (index) < (u64) (length) ? BOWL_HASH_PRIME : 1))
+
+/**
+ * Combines the hash with eight consecutive codepoints.
+ * @internal
+ */
+#define _BOWL_HASH_8(hash, codepoint, string, length, index) \
+_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(_BOWL_HASH_1(hash, codepoint, string, length, (index) + 0), codepoint, string, length, (index) + 1), codepoint, string, length, (index) + 2), codepoint, string, length, (index) + 3), codepoint, string, length, (index) + 4), codepoint, string, length, (index) + 5), codepoint, string, length, (index) + 6), codepoint, string, length, (index) + 7)
+
+/**
+ * Combines the hash with sixteen consecutive codepoints.
+ * @internal
+ */
+#define _BOWL_HASH_16(hash, codepoint, string, length, index) \
+_BOWL_HASH_8(_BOWL_HASH_8(hash, codepoint, string, length, (index) + 0), codepoint, string, length, (index) + 8)
+
+/**
+ * Combines the hash with sixty-four consecutive codepoints.
+ * @internal
+ */
+#define _BOWL_HASH_64(hash, codepoint, string, length, index) \
+_BOWL_HASH_16(_BOWL_HASH_16(_BOWL_HASH_16(_BOWL_HASH_16(hash, codepoint, string, length, (index) + 0), codepoint, string, length, (index) + 16), codepoint, string, length, (index) + 32), codepoint, string, length, (index) + 48)
+
+/**
+ * Returns the value of a definition of the 'BOWL_STATIC_*' macros.
+ * The value must never be modified.
+ * @param name The name of the definition.
+ * @return The static value.
+ */
+#define BOWL_STATIC_VALUE(name) ((BowlValue) &(name).value)
+
 /**
  * Defines a new static bowl string on basis of the provided unicode string literal.
+ * The hash is computed at compile time (see 'BOWL_STATIC_HASH_LIMIT'). The 
+ * definition is constant, thus it may reside in read-only memory.
  * @param string The unicode string literal using 32-bit unicode codepoints.
+ * @param length The number of codepoints.
  * @return A static definition which is named as given.
  */
 #define BOWL_STATIC_UNICODE_STRING(name, string, length) \
-static union {\
+static const union {\
     struct {\
         BowlValueType type;\
+        u32 flags;\
         BowlValue location;\
         u64 hash;\
         u64 l ## ength;\
@@ -116,51 +378,56 @@ static union {\
     struct bowl_value value;\
 } name = {\
     .type = BowlStringValue,\
+    .flags = BowlStaticFlag,\
     .location = NULL,\
-    .hash = 0,\
+    .hash = BOWL_UNICODE_HASH(string, length),\
     .l ## ength = (length),\
     .bytes = (string)\
 };
 
 /**
  * Defines a new static bowl string on basis of the provided C string literal.
- * @param string The C string literal.
- * @return A static definition which is named as given as well as a static initialization code which
- * initializes the codepoints of the resulting value using the ASCII values in the C string.
+ * The codepoints are stored with one byte per codepoint and the hash is computed
+ * at compile time (see 'BOWL_STATIC_HASH_LIMIT'). The definition is constant, 
+ * thus it may reside in read-only memory.
+ * @param string The C string literal, which must only contain ASCII characters.
+ * @return A static definition which is named as given.
  */
 #define BOWL_STATIC_ASCII_STRING(name, string) \
-static union {\
+static const union {\
     struct {\
         BowlValueType type;\
+        u32 flags;\
         BowlValue location;\
         u64 hash;\
         u64 length;\
-        u32 codepoints[sizeof(string) - 1];\
+        u8 codepoints[sizeof(string) - 1];\
     };\
     struct bowl_value value;\
 } name = {\
     .type = BowlStringValue,\
+    .flags = BowlStaticFlag | BowlLatin1Flag,\
     .location = NULL,\
-    .hash = 0,\
+    .hash = BOWL_ASCII_HASH(string),\
     .length = sizeof(string) - 1,\
-};\
-static bool CONCAT(_is_initialized, __LINE__) = false;\
-if (!CONCAT(_is_initialized, __LINE__)) {\
-    for (u64 i = 0; i < sizeof(string) - 1; ++i) {\
-        (name).codepoints[i] = (u32) (string)[i];\
-    }\
-    CONCAT(_is_initialized, __LINE__) = true;\
-}
+    .codepoints = (string)\
+};
 
 /**
  * Defines a new static bowl symbol on basis of the provided unicode string literal.
+ * Static symbols are not interned. Use 'bowl_symbol_intern' to obtain the 
+ * canonical instance if pointer comparisons are desired.
+ * The hash is computed at compile time (see 'BOWL_STATIC_HASH_LIMIT'). The 
+ * definition is constant, thus it may reside in read-only memory.
  * @param string The unicode string literal using 32-bit unicode codepoints.
+ * @param length The number of codepoints.
  * @return A static definition which is named as given.
  */
 #define BOWL_STATIC_UNICODE_SYMBOL(name, string, length) \
-static union {\
+static const union {\
     struct {\
         BowlValueType type;\
+        u32 flags;\
         BowlValue location;\
         u64 hash;\
         u64 l ## ength;\
@@ -169,41 +436,42 @@ static union {\
     struct bowl_value value;\
 } name = {\
     .type = BowlSymbolValue,\
+    .flags = BowlStaticFlag,\
     .location = NULL,\
-    .hash = 0,\
+    .hash = BOWL_UNICODE_HASH(string, length),\
     .l ## ength = (length),\
     .bytes = (string)\
 };
 
 /**
  * Defines a new static bowl symbol on basis of the provided C string literal.
- * @param symbol The C string literal.
- * @return A static definition which is named as given as well as a static initialization code which
- * initializes the codepoints of the resulting value using the ASCII values in the C string.
+ * Static symbols are not interned. Use 'bowl_symbol_intern' to obtain the 
+ * canonical instance if pointer comparisons are desired.
+ * The codepoints are stored with one byte per codepoint and the hash is computed
+ * at compile time (see 'BOWL_STATIC_HASH_LIMIT'). The definition is constant, 
+ * thus it may reside in read-only memory.
+ * @param symbol The C string literal, which must only contain ASCII characters.
+ * @return A static definition which is named as given.
  */
 #define BOWL_STATIC_ASCII_SYMBOL(name, symbol) \
-static union {\
+static const union {\
     struct {\
         BowlValueType type;\
+        u32 flags;\
         BowlValue location;\
         u64 hash;\
         u64 length;\
-        u32 codepoints[sizeof(symbol) - 1];\
+        u8 codepoints[sizeof(symbol) - 1];\
     };\
     struct bowl_value value;\
 } name = {\
     .type = BowlSymbolValue,\
+    .flags = BowlStaticFlag | BowlLatin1Flag,\
     .location = NULL,\
-    .hash = 0,\
-    .length = sizeof(symbol) - 1\
-};\
-static bool CONCAT(_is_initialized, __LINE__) = false;\
-if (!CONCAT(_is_initialized, __LINE__)) {\
-    for (u64 i = 0; i < sizeof(symbol) - 1; ++i) {\
-        (name).codepoints[i] = (u32) (symbol)[i];\
-    }\
-    CONCAT(_is_initialized, __LINE__) = true;\
-}
+    .hash = BOWL_ASCII_HASH(symbol),\
+    .length = sizeof(symbol) - 1,\
+    .codepoints = (symbol)\
+};
 
 /**
  * Assigns the provided 'value' to the given 'temporary' variable and checks 
@@ -214,7 +482,13 @@ if (!CONCAT(_is_initialized, __LINE__)) {\
  * @param temporary A memory location where the value should be temporarily stored.
  * @param A value of type 'BowlResult'.
  */
-#define BOWL_STACK_PUSH_VALUE_USE_TEMPORARY(stack, temporary, value) BOWL_TRY_USE_TEMPORARY((stack)->datastack, (temporary), bowl_list((stack), (value), *((stack)->datastack)))
+#define BOWL_STACK_PUSH_VALUE_USE_TEMPORARY(stack, temporary, value) \
+*(temporary) = (value);\
+if ((temporary)->failure) {\
+    return (temporary)->exception;\
+}\
+_BOWL_STACK_RESERVE(stack, 1);\
+(stack)->datastack->elements[(stack)->datastack->length++] = (temporary)->_BOWL_RESULT_VALUE_FIELD_NAME;
 
 /**
  * Creates a new temporary variable, assigns the provided 'value' to it and 
@@ -242,52 +516,139 @@ if (!CONCAT(_is_initialized, __LINE__)) {\
  */
 #define BOWL_STACK_PUSH_VALUE(stack, value) BOWL_STACK_PUSH_VALUE_USE_FRESH_TEMPORARY(stack, CONCAT(_result, __LINE__), value)
 
+/**
+ * Pushes the provided values onto the datastack at once. 
+ * The values are pushed in the order in which they appear in the array. That
+ * is, the last element ends up at the top of the datastack.
+ * @param stack The stack of the current environment.
+ * @param count The number of values to push.
+ * @param values An array of at least 'count' values of type 'BowlValue'.
+ */
+#define BOWL_STACK_PUSH_N(stack, count, values) \
+_BOWL_STACK_RESERVE(stack, count);\
+memcpy((stack)->datastack->elements + (stack)->datastack->length, (values), (u64) (count) * sizeof(BowlValue));\
+(stack)->datastack->length += (u64) (count);
+
+/**
+ * Ensures that the datastack is able to hold the provided number of additional
+ * values or returns the exception otherwise.
+ * @internal
+ */
+#define _BOWL_STACK_RESERVE(stack, count) \
+if ((stack)->datastack->capacity - (stack)->datastack->length < (u64) (count)) {\
+    BowlValue const CONCAT(_exception, __LINE__) = bowl_datastack_reserve((stack), (u64) (count));\
+    if (CONCAT(_exception, __LINE__) != NULL) {\
+        return CONCAT(_exception, __LINE__);\
+    }\
+}
+
 /**
  * The path to the boot image as defined by the CLI.
+ * This is the default for isolates which are created without explicit settings.
+ * @see bowl_image_load
  */
 extern const char *bowl_settings_boot_path;
 
 /**
  * The path to the kernel library as defined by the CLI.
+ * This is the default for isolates which are created without explicit settings.
  */
 extern const char *bowl_settings_kernel_path;
 
 /**
  * The level of verbosity as defined by the CLI.
+ * This is the default for isolates which are created without explicit settings.
  */
 extern u64 bowl_settings_verbosity;
 
+/**
+ * The size of the nursery in bytes as defined by the CLI.
+ * This is the default for isolates which are created without explicit settings.
+ */
+extern u64 bowl_settings_nursery_size;
+
+/**
+ * The maximum number of finalizers which are executed at a single safepoint 
+ * (see 'bowl_finalizer_register'). Remaining finalizers are executed at the
+ * next safepoint. A value of '0' drains the queue.
+ */
+extern u64 bowl_settings_finalizer_batch;
+
+/**
+ * The first byte of the immortal region.
+ * 
+ * The immortal region contains values which live as long as the process (e.g.
+ * the preallocated values below and the boot image). It is shared by all
+ * isolates, which never write to it. Since there is only one boot image per
+ * process, the region is a single address range. It is set once when the boot
+ * image is mapped and covers the image even if it could not be mapped at its
+ * preferred address. The garbage collector 
+ * never scans, relocates or frees values in the immortal region. Since values
+ * in the immortal region only refer to other immortal values, none of their
+ * references need to be traced either.
+ */
+extern u8 *bowl_immortal_begin;
+
+/**
+ * The first byte after the immortal region.
+ * @see bowl_immortal_begin
+ */
+extern u8 *bowl_immortal_end;
+
+/**
+ * Checks whether the provided heap value is immortal. That is, it either resides
+ * in the immortal region or in static memory (e.g. values which were defined 
+ * using the 'BOWL_STATIC_*' macros).
+ * The address range is tested first, so values in the immortal region are not
+ * dereferenced.
+ * @param value A heap value (see 'BOWL_IS_HEAP_VALUE').
+ * @return Whether or not the value is immortal.
+ */
+#define BOWL_IS_IMMORTAL(value) \
+((uintptr_t) (value) - (uintptr_t) bowl_immortal_begin < (uintptr_t) bowl_immortal_end - (uintptr_t) bowl_immortal_begin || ((value)->flags & BowlStaticFlag) != 0)
+
 /**
  * A preallocated sentinel value which can be used for any purpose where it is
  * required to pass dummy data that is not used in any meaningful way.
  * 
  * A common example of this value's application is its use as the default argument
  * for the 'bowl_map_get_or_else' function to check if the provided key was present
- * in the map.
+ * in the map. This value resides in the immortal region.
  */
 extern const BowlValue bowl_sentinel_value;
 
+/**
+ * A preallocated value which replaces the target of a weak value as soon as 
+ * the target has been collected (see 'bowl_weak').
+ * This value resides in the immortal region.
+ */
+extern const BowlValue bowl_weak_cleared;
+
 /**
  * A preallocated string exception which is used whenever the finalization of
  * a native library failed.
+ * This value resides in the immortal region.
  */
 extern const BowlValue bowl_exception_finalization_failure;
 
 /**
  * A preallocated string exception which is used whenever there is not enough 
  * heap memory available.
+ * This value resides in the immortal region.
  */
 extern const BowlValue bowl_exception_out_of_heap;
 
 /**
  * A preallocated string exception which is used whenever a malformed UTF-8
  * sequence is encountered.
+ * This value resides in the immortal region.
  */
 extern const BowlValue bowl_exception_malformed_utf8;
 
 /**
  * A preallocated string exception which is used whenever an incomplete UTF-8
  * sequence is encountered.
+ * This value resides in the immortal region.
  */
 extern const BowlValue bowl_exception_incomplete_utf8;
 
@@ -320,6 +681,17 @@ typedef struct {
     BowlFunction function;
 } BowlFunctionEntry;
 
+/**
+ * The table of all function entries of the module, which is terminated by an
+ * entry whose name is 'NULL'.
+ * 
+ * This table may optionally be exported by the module author (see 'module.h').
+ * It is required if functions of the module should be written into boot 
+ * images or heap snapshots, since their function pointers are looked up by 
+ * entry name in this table when the image is loaded (see 'BowlImageFunction').
+ * The runtime never registers the entries of this table on its own.
+ */
+extern BowlFunctionEntry bowl_module_entries[];
 /**
  * Registers the provided entry using the function 'bowl_register_function'.
  * @param stack The current stack of the environment.
@@ -331,7 +703,32 @@ typedef struct {
 extern BowlValue bowl_register(BowlStack stack, BowlValue library, BowlFunctionEntry entry);
 
 /**
- * Registers all provided entries using the function 'bowl_register'.
+ * Registers the provided extension type for the given library.
+ * Values of the extension type may only be created after the registration.
+ * 
+ * The registry is shared by all isolates of the process, since extension 
+ * values may be transferred between them. Registering the same descriptor 
+ * again has no effect, so the 'bowl_module_initialize' function of a library
+ * may register its types in every isolate which loads it.
+ * @param stack The current stack of the environment.
+ * @param library The library value to which the extension type belongs.
+ * @param descriptor The descriptor of the extension type.
+ * @return Either an exception (e.g. if another descriptor with the same name 
+ * has been registered) or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_register_extension(BowlStack stack, BowlValue library, const BowlExtensionType *descriptor);
+
+/**
+ * Registers all provided entries at once.
+ * The names of the entries are interned. That is, names which already have a
+ * canonical symbol in the symbol table of the stack's isolate reuse it (see 
+ * 'bowl_symbol_find'). The missing symbols, the function values and the 
+ * documentation strings of all entries are allocated using a single call to 
+ * 'bowl_allocate_all', and the new symbols are entered into the symbol table
+ * before any of them is used. Thus, lookups of the registered names in the 
+ * dictionary compare the symbols by identity. The functions are inserted into
+ * a transient version of the dictionary, which is persisted once all entries 
+ * are registered. Thus, the dictionary is rebuilt exactly once.
  * @param stack The current stack of the environment.
  * @param library The library value to which the associated function belongs. This value may
  * be 'NULL' if the function belongs to no native library.
@@ -350,12 +747,124 @@ extern BowlValue bowl_register_all(BowlStack stack, BowlValue library, BowlFunct
 extern void bowl_value_debug(BowlValue value, char *message, ...);
 
 /**
- * Triggers a run of the garbage collector. 
+ * Triggers a major run of the garbage collector, which collects the nursery as
+ * well as the old generation. 
+ * Immediate values are neither traced nor relocated by the garbage collector.
+ * The same applies to immortal values (see 'BOWL_IS_IMMORTAL') and values in
+ * shared chunks, which are only marked in order to keep their chunks alive.
+ * The symbol table is treated as a weak root. That is, interned symbols which 
+ * are not reachable otherwise are removed from it. Immortal symbols (e.g. the
+ * symbols of the boot image) are never removed.
  * @param stack The current stack of the environment.
  * @return Either an exception or 'NULL' if no exception occurred.
  */
 extern BowlValue bowl_collect_garbage(BowlStack stack);
 
+/**
+ * Triggers a minor run of the garbage collector, which only collects the 
+ * nursery. Values which survive a minor collection are promoted to the old
+ * generation. The roots of a minor collection are the stack and the remembered
+ * set. Hence, the duration of a minor collection only depends on the number 
+ * of live values in the nursery.
+ * @param stack The current stack of the environment.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_collect_nursery(BowlStack stack);
+
+/**
+ * The interface of finalizers.
+ * 
+ * A finalizer accepts the stack of the current environment and the data which
+ * was passed to 'bowl_finalizer_register'. Since the associated value has 
+ * already been collected when a finalizer runs, it is not passed. Finalizers 
+ * may allocate, but they must not register further finalizers for the data.
+ */
+typedef void (*BowlFinalizer)(BowlStack, void *);
+
+/**
+ * Registers a finalizer which is executed after the provided value has been 
+ * collected, e.g. in order to close a file descriptor or to unmap memory which
+ * is wrapped by the value.
+ * 
+ * Finalizers are not executed within the pause of the garbage collector. The 
+ * collector only moves the finalizers of dead values to a queue, which is 
+ * processed in batches of 'bowl_settings_finalizer_batch' finalizers at 
+ * safepoints only. That is, when control returns to the interpreter after the 
+ * native function whose allocation triggered the collection or when 
+ * 'bowl_finalizers_run' is called. Thus, finalizers never run within an 
+ * allocation (e.g. 'bowl_allocate_all' or 'bowl_map_transient_put'). All 
+ * remaining finalizers are executed by 'bowl_isolate_destroy'. A value may 
+ * have any number of finalizers, which are executed in the reverse order of 
+ * their registration.
+ * 
+ * Registrations belong to the value rather than to its memory location. When
+ * a value is moved by 'bowl_share' or handed off by 'bowl_task_group_join',
+ * its finalizers move with it and the abandoned original never triggers them.
+ * The finalizers of a shared value are queued in the isolate which releases 
+ * its chunk last, or executed by 'bowl_channel_destroy' using the default
+ * isolate if the chunk is released by the channel. Copies created by 
+ * 'bowl_value_clone' do not have finalizers, and the finalizers of a value
+ * which is moved into the immortal region by 'bowl_immortalize' are dropped.
+ * @param stack The current stack of the environment.
+ * @param value The value which is observed. Immediate and immortal values are
+ * never collected and thus not allowed.
+ * @param finalizer The finalizer.
+ * @param data The data which is passed to the finalizer.
+ * @return Whether or not there was enough memory.
+ */
+extern bool bowl_finalizer_register(BowlStack stack, BowlValue value, BowlFinalizer finalizer, void *data);
+
+/**
+ * Executes at most the provided number of queued finalizers.
+ * This function is called by the interpreter at safepoints, but may also be 
+ * called directly by native functions in order to drain the queue at a 
+ * convenient point. It must not be called while values are held outside of 
+ * managed locations, since finalizers may allocate.
+ * @param stack The current stack of the environment.
+ * @param limit The maximum number of finalizers to execute.
+ * @return The number of finalizers which are still queued.
+ */
+extern u64 bowl_finalizers_run(BowlStack stack, u64 limit);
+
+/**
+ * Adds the provided value of the old generation to the remembered set.
+ * If the remembered set cannot grow, the next minor collection is performed as
+ * a major one instead. 
+ * This function should not be called directly. Use 'BOWL_WRITE_BARRIER' instead.
+ * @param stack The current stack of the environment.
+ * @param object The value which may refer to values in the nursery.
+ */
+extern void bowl_remember(BowlStack stack, BowlValue object);
+
+/**
+ * Grows the datastack of the current environment such that it is able to hold
+ * at least the provided number of additional values.
+ * This function never triggers the garbage collector, since the elements of the
+ * datastack do not reside in the heap.
+ * @param stack The current stack of the environment.
+ * @param count The number of additional values.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_datastack_reserve(BowlStack stack, u64 count);
+
+/**
+ * Materializes the datastack of the current environment as a list.
+ * The head of the resulting list is the top of the datastack.
+ * @param stack The current stack of the environment.
+ * @return Either the list or an exception.
+ */
+extern BowlResult bowl_datastack_to_list(BowlStack stack);
+
+/**
+ * Replaces the contents of the datastack of the current environment by the 
+ * elements of the provided list. 
+ * The head of the list becomes the top of the datastack.
+ * @param stack The current stack of the environment.
+ * @param list The list whose elements should be placed on the datastack.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_datastack_from_list(BowlStack stack, BowlValue list);
+
 /**
  * Tokenizes the provided string by separating values at white space characters.
  * @param stack The current stack of the environment.
@@ -369,6 +878,12 @@ extern BowlResult bowl_tokens(BowlStack stack, BowlValue string);
  * Value type dependent fields are not initialized by this function. That is,
  * to ensure that the garbage collector can work correctly, it is required to
  * initialize all structure members before any other allocation.
+ * Values are allocated by bumping a pointer in the nursery of the stack's 
+ * isolate, which triggers a minor collection whenever it is exhausted. Values
+ * which do not fit into the nursery are allocated in the old generation 
+ * directly. Such values are added to the remembered set immediately, since 
+ * their initialization may store references to values in the nursery without
+ * executing the write barrier.
  * @param stack The current stack of the environment.
  * @param type The type of the value.
  * @param additional The number of additional bytes which should be allocated.
@@ -376,8 +891,39 @@ extern BowlResult bowl_tokens(BowlStack stack, BowlValue string);
  */
 extern BowlResult bowl_allocate(BowlStack stack, BowlValueType type, u64 additional);
 
+/**
+ * Allocates memory for several values using a single contiguous allocation.
+ * Either all or none of the values are allocated. As for 'bowl_allocate', value
+ * type dependent fields are not initialized. Since the provided array is not 
+ * managed by the garbage collector, all values must be initialized and stored
+ * in managed locations before any other allocation. Symbols which are allocated
+ * by this function are not interned. 
+ * @param stack The current stack of the environment.
+ * @param count The number of values to allocate.
+ * @param types An array of 'count' elements which contains the type of each value.
+ * @param additional An array of 'count' elements which contains the number of 
+ * additional bytes of each value.
+ * @param values An array of at least 'count' elements where the allocated values
+ * are stored.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_allocate_all(BowlStack stack, u64 count, BowlValueType *types, u64 *additional, BowlValue *values);
+
+/**
+ * Moves a deep copy of the provided value into the immortal region.
+ * Values which are already immortal are shared instead of copied. Since the 
+ * immortal region is never collected, this should only be used for values 
+ * which are required during the entire lifetime of the process.
+ * @param stack The current stack of the environment.
+ * @param value The value which should become immortal.
+ * @return Either the immortal copy of the provided value or the exception.
+ */
+extern BowlResult bowl_immortalize(BowlStack stack, BowlValue value);
+
 /**
  * Creates an exact copy of the provided value.
+ * Immediate values and interned symbols are returned as they are. Extension
+ * values are copied using the 'clone' callback of their descriptor.
  * @param stack The current stack of the environment.
  * @param value The value which should be cloned.
  * @return Either the copy of the provided value or the exception.
@@ -386,6 +932,8 @@ extern BowlResult bowl_value_clone(BowlStack stack, BowlValue value);
 
 /**
  * Deletes the specified key from the provided map.
+ * Only the nodes on the path to the key are copied, which takes logarithmic
+ * time. All other nodes are shared with the provided map.
  * @param stack The stack of the current environment.
  * @param map The map whose key should be deleted.
  * @param key The key to delete.
@@ -395,6 +943,9 @@ BowlResult bowl_map_delete(BowlStack stack, BowlValue map, BowlValue key);
 
 /**
  * Merges the two provided maps into a new one.
+ * Subtrees which are only present in one of the two maps or which are identical
+ * in both maps are shared with the resulting map. All other entries are inserted
+ * into a transient map, so each node is copied at most once.
  * @param stack The stack of the current environment.
  * @param a The first map.
  * @param b The second map.
@@ -405,6 +956,8 @@ BowlResult bowl_map_merge(BowlStack stack, BowlValue a, BowlValue b);
 /** 
  * Retrieves the value from the provided map which is associated with the specified
  * key or returns a default value if there is no value associated with the key.
+ * Interned symbols are compared by identity, thus a lookup with such a key never
+ * compares any codepoints.
  * @param map A value of type 'map'.
  * @param key An arbitrary value which represents the key.
  * @param otherwise An arbitrary default value. The 'bowl_sentinel_value' may be used
@@ -415,6 +968,7 @@ extern BowlValue bowl_map_get_or_else(BowlValue map, BowlValue key, BowlValue ot
 
 /**
  * Tests whether the second argument is a subset of the first one.
+ * Subtrees which are identical in both maps are skipped without inspecting them.
  * @param superset A value of type 'map'.
  * @param subset A value of type 'map'.
  * @return Whether or not the second argument is a subset of the first one.
@@ -425,6 +979,8 @@ extern bool bowl_map_subset_of(BowlValue superset, BowlValue subset);
  * Inserts the value at the specified key in the provided map. 
  * If there is already a value associated with this key, the old value will 
  * be overwritten by the new one.
+ * Only the nodes on the path to the key are copied, which takes logarithmic
+ * time. All other nodes are shared with the provided map.
  * @param stack The current stack of the environment.
  * @param map The map in which the value should be inserted.
  * @param key The key which should be associated with the value.
@@ -434,6 +990,53 @@ extern bool bowl_map_subset_of(BowlValue superset, BowlValue subset);
  */
 extern BowlResult bowl_map_put(BowlStack stack, BowlValue map, BowlValue key, BowlValue value);
 
+/**
+ * Creates a transient version of the provided map in constant time.
+ * 
+ * A transient map may be modified in place using 'bowl_map_transient_put' and 
+ * 'bowl_map_transient_delete' until it is turned back into an ordinary map by
+ * 'bowl_map_persist'. The provided map itself remains unchanged, since its 
+ * nodes are copied on the first modification. A transient map must neither be
+ * shared with other native functions nor be passed to bowl code. However, it 
+ * may be passed to functions that only read maps (e.g. 'bowl_map_get_or_else').
+ * @param stack The current stack of the environment.
+ * @param map The map whose transient version should be created.
+ * @return Either the transient map or an exception.
+ */
+extern BowlResult bowl_map_transient(BowlStack stack, BowlValue map);
+
+/**
+ * Inserts the value at the specified key in the provided transient map.
+ * Nodes which are owned by the transient map are modified in place. The 
+ * transient map should be stored in a register, since it may be relocated by
+ * the garbage collector.
+ * @param stack The current stack of the environment.
+ * @param transient The transient map in which the value should be inserted.
+ * @param key The key which should be associated with the value.
+ * @param value The value which should be inserted.
+ * @return Either the transient map or an exception.
+ */
+extern BowlResult bowl_map_transient_put(BowlStack stack, BowlValue transient, BowlValue key, BowlValue value);
+
+/**
+ * Deletes the specified key from the provided transient map.
+ * Nodes which are owned by the transient map are modified in place.
+ * @param stack The current stack of the environment.
+ * @param transient The transient map whose key should be deleted.
+ * @param key The key to delete.
+ * @return Either the transient map or an exception.
+ */
+extern BowlResult bowl_map_transient_delete(BowlStack stack, BowlValue transient, BowlValue key);
+
+/**
+ * Turns the provided transient map into an ordinary map in constant time.
+ * This function does not allocate. The transient map must not be modified
+ * afterwards.
+ * @param transient The transient map.
+ * @return The map value.
+ */
+extern BowlValue bowl_map_persist(BowlValue transient);
+
 /**
  * Checks if the specified library is currently loaded.
  * @param path The file path to the library.
@@ -441,8 +1044,45 @@ extern BowlResult bowl_map_put(BowlStack stack, BowlValue map, BowlValue key, Bo
  */
 extern bool bowl_library_is_loaded(char *path);
 
+/**
+ * The initial state of the hash of strings and symbols.
+ * @see bowl_value_hash
+ */
+#define BOWL_HASH_OFFSET_BASIS UINT64_C(0xCBF29CE484222325)
+
+/**
+ * The multiplier of the hash of strings and symbols.
+ * @see bowl_value_hash
+ */
+#define BOWL_HASH_PRIME UINT64_C(0x100000001B3)
+
+/**
+ * Computes the hash of a string or symbol with the provided codepoints.
+ * @param codepoints The codepoints of the string or symbol.
+ * @param length The number of codepoints.
+ * @return The hash as computed by 'bowl_value_hash'.
+ */
+static inline u64 bowl_hash_codepoints(u32 const *codepoints, u64 length) {
+    u64 hash = BOWL_HASH_OFFSET_BASIS;
+    for (u64 i = 0; i < length; ++i) {
+        hash = (hash ^ codepoints[i]) * BOWL_HASH_PRIME;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
 /**
  * Computes the hash of the provided value.
+ * The hash of strings and symbols only depends on their codepoints and not on
+ * their representation. Starting with 'BOWL_HASH_OFFSET_BASIS', each codepoint
+ * is combined with the hash using a bitwise exclusive or, followed by a 
+ * multiplication with 'BOWL_HASH_PRIME'. If the result is '0', the hash is '1'
+ * instead, since '0' indicates that the hash is not yet computed.
+ * The hash of immortal values (e.g. static values) is never stored. Other hashes
+ * are loaded and stored using relaxed atomic operations, so that several 
+ * threads may hash the same value concurrently (see 'BowlTask').
+ * Immediate values are hashed on basis of their encoding and are therefore
+ * never dereferenced. The only exception is '-0.0', which has the same hash 
+ * as '0.0'.
  * @param value The value to hash.
  * @return The hash of the provided value.
  */
@@ -450,6 +1090,15 @@ extern u64 bowl_value_hash(BowlValue value);
 
 /**
  * Tests whether the two provided values are equal.
+ * Strings and symbols are compared codepoint by codepoint without widening 
+ * them, regardless of their representations.
+ * Immediate values are compared without dereferencing them. Symbols are 
+ * compared by identity if both of them are interned. In contrast to IEEE 754,
+ * numbers are equal if they are either both zero (i.e. '0.0' equals '-0.0') 
+ * or both NaN, which is consistent with 'bowl_value_hash'. This applies to 
+ * boxed and immediate numbers alike.
+ * Since arrays are mutable, they are compared by identity. Their elements are
+ * never compared, hence an array only equals itself even if it contains NaN.
  * @param a The first value.
  * @param b The second value.
  * @return Whether or not the two values are equal.
@@ -459,7 +1108,11 @@ extern bool bowl_value_equals(BowlValue a, BowlValue b);
 /**
  * Computes the actual byte size of the provided value.
  * This takes any variable sized members into account and is therefore at 
- * least 'sizeof(struct bowl_value)'.
+ * least 'sizeof(struct bowl_value)'. The only exceptions are immediate values
+ * whose byte size is '0'. The byte size of extension values is computed by 
+ * their descriptor.
+ * Like hashing, comparing, printing and tracing, this operation dispatches 
+ * through a table which is indexed by the type of the value.
  * @param value The value whose byte size should be computed.
  * @return The hash of the value. 
  */
@@ -468,6 +1121,8 @@ extern u64 bowl_value_byte_size(BowlValue value);
 /**
  * Prints the string representation of the provided value into the specified
  * stream.
+ * Strings are encoded in bulk directly into the stream's buffer whenever 
+ * possible, so no intermediate memory is allocated.
  * @param stream The output stream to use.
  * @param value The value to print.
  */
@@ -486,10 +1141,26 @@ extern void bowl_value_dump(FILE *stream, BowlValue value);
  */
 extern void bowl_value_show(BowlValue value, char **buffer, u64 *length);
 
+/**
+ * Computes a string representation of the provided value and stores it in the
+ * provided memory location without allocating any memory.
+ * At most 'capacity' bytes are written, including the terminating null character.
+ * Thus, the string representation was truncated if the returned length is not
+ * less than 'capacity'.
+ * @param value The value whose string representation should be computed.
+ * @param buffer The memory location where the string representation should be stored.
+ * This may be 'NULL' if 'capacity' is '0'.
+ * @param capacity The number of bytes which are available at the memory location.
+ * @return The length of the complete string representation in bytes, excluding the 
+ * terminating null character.
+ */
+extern u64 bowl_value_show_into(BowlValue value, char *buffer, u64 capacity);
+
 /** 
  * Returns the length of the provided value. 
- * That is, the type of the value must be either a 'string', 'map', 'list' or
- * 'symbol'.
+ * That is, the type of the value must be either a 'string', 'map', 'list', 
+ * 'symbol' or 'array'. The length of strings and symbols is the number of 
+ * codepoints in any representation.
  * @param value The value whose length should be returned.
  * @return The length of the value.
  */
@@ -497,6 +1168,9 @@ extern u64 bowl_value_length(BowlValue value);
 
 /**
  * Returns a string representation of the value's type.
+ * The type of extension values is the name of their descriptor, which is 
+ * copied into the immortal region when the descriptor is registered. Thus, 
+ * the returned string remains valid as long as the process.
  * @param value The value whose type's string representation should be returned.
  * @return The string representation of the value's type.
  */
@@ -511,6 +1185,7 @@ extern char *bowl_type_name(BowlValueType type);
 
 /**
  * Creates a new exception on basis of the message and its format data.
+ * In contrast to 'bowl_lazy_exception', the message is formatted immediately.
  * @param stack The current stack of the environment.
  * @param message The message which may contain format specifiers.
  * @param ... The variable number of format data.
@@ -519,8 +1194,59 @@ extern char *bowl_type_name(BowlValueType type);
  */
 extern BowlResult bowl_format_exception(BowlStack stack, char *message, ...);
 
+/**
+ * The message templates of lazy exceptions, indexed by 'BowlExceptionTemplate'.
+ */
+extern const char *const bowl_exception_templates[];
+
+/**
+ * Creates a new lazy exception on basis of the provided template and arguments.
+ * 
+ * Neither the message is formatted nor any string value is created. Instead, 
+ * the template and its arguments are stored in the exception itself, whose 
+ * arguments are allocated as additional bytes. The exception is taken from a 
+ * pool of such exception cells which is preallocated for each isolate and 
+ * refilled after each collection. Thus, this function never triggers the 
+ * garbage collector. If the pool is exhausted and there is not enough heap 
+ * memory available, 'bowl_exception_out_of_heap' is returned.
+ * 
+ * The arguments are not copied. They must either be string literals of the 
+ * runtime or of a native library, or names which are returned by 
+ * 'bowl_value_type' and 'bowl_type_name'. Before a native library is 
+ * unloaded, the messages of all lazy exceptions of the isolate are rendered, 
+ * so strings of the library may be used as arguments as well.
+ * 
+ * A lazy exception never leaves the heap of its isolate. That is, the message 
+ * is rendered whenever a lazy exception is copied elsewhere (e.g. by 
+ * 'bowl_share', 'bowl_immortalize' or 'bowl_image_write').
+ * @param stack The current stack of the environment.
+ * @param template_id The template of the message.
+ * @param first The first argument of the template or 'NULL'.
+ * @param second The second argument of the template or 'NULL'.
+ * @param third The third argument of the template or 'NULL'.
+ * @return The exception.
+ */
+extern BowlValue bowl_lazy_exception(BowlStack stack, BowlExceptionTemplate template_id, const char *first, const char *second, const char *third);
+
+/**
+ * Returns the message of the provided exception.
+ * The message of a lazy exception is rendered and stored in the exception on
+ * first use. Messages are only stored in exceptions which reside in the heap
+ * of the stack's isolate. Thus, immortal or shared exceptions are never 
+ * written to, even though they are never lazy in the first place (see 
+ * 'bowl_lazy_exception'). Printing an exception (e.g. using 'bowl_value_dump')
+ * renders its message without creating a string value.
+ * @param stack The current stack of the environment.
+ * @param exception A value of type 'exception'.
+ * @return Either the message or an exception (e.g. in case of a heap overflow).
+ */
+extern BowlResult bowl_exception_message(BowlStack stack, BowlValue exception);
+
 /**
  * The constructor for symbol values. 
+ * The resulting symbol is interned. That is, if there already is an equal 
+ * symbol in the symbol table of the stack's isolate, this symbol is returned 
+ * without allocating a new one. The hash of the symbol is computed in advance.
  * @param stack The current stack of the environment.
  * @param codepoints The unicode codepoints of this symbol.
  * @param length The number of codepoints.
@@ -530,6 +1256,9 @@ extern BowlResult bowl_symbol(BowlStack stack, u32 *codepoints, u64 length);
 
 /**
  * The constructor for symbol values using an UTF-8 encoded string.
+ * The resulting symbol is interned. Its representation is chosen automatically
+ * in the same way as for 'bowl_string_utf8'.
+ * @see bowl_symbol
  * @param stack The current stack of the environment.
  * @param bytes The UTF-8 byte sequence.
  * @param length The number of bytes in the byte sequence.
@@ -537,6 +1266,27 @@ extern BowlResult bowl_symbol(BowlStack stack, u32 *codepoints, u64 length);
  */
 extern BowlResult bowl_symbol_utf8(BowlStack stack, u8 *bytes, u64 length);
 
+/**
+ * Returns the canonical instance of the provided symbol. 
+ * If the symbol table does not yet contain an equal symbol, a copy of the
+ * provided symbol is entered into it. This is mostly useful for static symbols,
+ * which are not interned by default.
+ * @param stack The current stack of the environment.
+ * @param symbol A value of type 'symbol'.
+ * @return Either an exception (e.g. in case of a heap overflow) or the interned symbol.
+ */
+extern BowlResult bowl_symbol_intern(BowlStack stack, BowlValue symbol);
+
+/**
+ * Looks up the canonical symbol with the provided name in the symbol table of
+ * the stack's isolate. This function never allocates.
+ * @param stack The current stack of the environment.
+ * @param bytes The UTF-8 encoded name of the symbol.
+ * @param length The number of bytes of the name.
+ * @return The interned symbol or 'NULL' if there is none.
+ */
+extern BowlValue bowl_symbol_find(BowlStack stack, u8 *bytes, u64 length);
+
 /**
  * The constructor for string values. 
  * @param stack The current stack of the environment.
@@ -548,6 +1298,14 @@ extern BowlResult bowl_string(BowlStack stack, u32 *codepoints, u64 length);
 
 /**
  * The constructor for string values using an UTF-8 encoded string.
+ * The representation of the string is chosen automatically: if all codepoints
+ * are less than 256, one byte per codepoint is used. Otherwise, the bytes are 
+ * copied as they are and a codepoint index is added if the string is longer 
+ * than 'BOWL_UTF8_INDEX_STRIDE' codepoints. The byte sequence is validated and
+ * decoded using the vectorized routines of 'unicode.h' (i.e. 'unicode_utf8_narrow'
+ * for the former and 'unicode_utf8_count' for the latter representation). Malformed and incomplete
+ * byte sequences result in 'bowl_exception_malformed_utf8' and 
+ * 'bowl_exception_incomplete_utf8' respectively.
  * @param stack The current stack of the environment.
  * @param bytes The UTF-8 byte sequence.
  * @param length The number of bytes in the byte sequence.
@@ -555,6 +1313,34 @@ extern BowlResult bowl_string(BowlStack stack, u32 *codepoints, u64 length);
  */
 extern BowlResult bowl_string_utf8(BowlStack stack, u8 *bytes, u64 length);
 
+/**
+ * The constructor for string values using one byte per codepoint.
+ * @param stack The current stack of the environment.
+ * @param codepoints The unicode codepoints of this string, which are all less than 256.
+ * @param length The number of unicode codepoints.
+ * @return Either an exception (e.g. in case of a heap overflow) or the string.
+ */
+extern BowlResult bowl_string_latin1(BowlStack stack, u8 *codepoints, u64 length);
+
+/**
+ * Returns the codepoint at the provided index of a string or symbol.
+ * This operation takes constant time for all representations but UTF-8. For
+ * UTF-8 encoded values the codepoint index is used to skip the preceding bytes.
+ * @param value A value of type 'string' or 'symbol'.
+ * @param index The index of the codepoint, which must be less than the length of the value.
+ * @return The codepoint.
+ */
+extern u32 bowl_string_codepoint_at(BowlValue value, u64 index);
+
+/**
+ * Copies the codepoints of a string or symbol using UTF-32 into the provided 
+ * memory location.
+ * @param value A value of type 'string' or 'symbol'.
+ * @param codepoints A memory location which is able to hold at least 'bowl_value_length(value)'
+ * codepoints.
+ */
+extern void bowl_string_widen(BowlValue value, u32 *codepoints);
+
 /**
  * The constructor for native function values. 
  * @param stack The current stack of the environment.
@@ -585,13 +1371,48 @@ extern BowlResult bowl_list_reverse(BowlStack stack, BowlValue list);
 /**
  * The constructor for map values. 
  * @param stack The current stack of the environment.
- * @param capacity The number of buckets this map should have.
- * @return Either an exception (e.g. in case of a heap overflow) or the map value.
+ * @param capacity The expected number of elements. Since maps grow on demand, 
+ * this is only a hint.
+ * @return Either an exception (e.g. in case of a heap overflow) or the empty map value.
  */
 extern BowlResult bowl_map(BowlStack stack, u64 capacity);
 
+/**
+ * A structure which is used to iterate over all keys and values of a map.
+ * 
+ * The iterator holds references to the nodes of the map which are not managed
+ * by the garbage collector. That is, no allocation may take place while the 
+ * iterator is in use.
+ */
+typedef struct {
+    /** The nodes on the path from the root to the current node. */
+    BowlValue nodes[BOWL_MAP_MAX_DEPTH];
+    /** The index of the next slot for each node on the path. */
+    u64 positions[BOWL_MAP_MAX_DEPTH];
+    /** The depth of the current node or '-1' if the iteration is complete. */
+    s64 depth;
+} BowlMapIterator;
+
+/**
+ * Initializes the provided iterator such that it iterates over the given map.
+ * @param iterator The iterator to initialize.
+ * @param map A value of type 'map'.
+ */
+extern void bowl_map_iterator(BowlMapIterator *iterator, BowlValue map);
+
+/**
+ * Advances the provided iterator to the next element of the map.
+ * @param iterator The iterator to advance.
+ * @param key A memory location where the key of the element should be stored.
+ * @param value A memory location where the value of the element should be stored.
+ * @return Whether or not there was another element.
+ */
+extern bool bowl_map_iterator_next(BowlMapIterator *iterator, BowlValue *key, BowlValue *value);
+
 /**
  * The constructor for number values. 
+ * If immediate values are supported, this function never allocates and never
+ * fails (see 'BOWL_NUMBER').
  * @param stack The current stack of the environment.
  * @param value The IEEE 754 encoded value with double precision.
  * @return Either an exception (e.g. in case of a heap overflow) or the number value.
@@ -608,6 +1429,8 @@ extern BowlResult bowl_library(BowlStack stack, char *path);
 
 /**
  * The constructor for boolean values. 
+ * If immediate values are supported, this function never allocates and never
+ * fails (see 'BOWL_BOOLEAN').
  * @param stack The current stack of the environment.
  * @param value The boolean value. 
  * @return Either an exception (e.g. in case of a heap overflow) or the boolean value.
@@ -623,6 +1446,117 @@ extern BowlResult bowl_boolean(BowlStack stack, bool value);
  */
 extern BowlResult bowl_vector(BowlStack stack, BowlValue value, u64 const length);
 
+/**
+ * The constructor for weak values.
+ * A weak value refers to its target without keeping it alive. As soon as the
+ * target is collected, the weak value refers to 'bowl_weak_cleared' instead.
+ * 
+ * Weak values in the nursery are processed by every collection. Weak values
+ * in the old generation are processed by major collections only: a minor 
+ * collection treats the targets of remembered weak values as strongly 
+ * reachable, which promotes them. Hence, a weak value is cleared by the first
+ * collection which processes it after its target became unreachable.
+ * @param stack The current stack of the environment.
+ * @param target The value to which the weak value refers, which must not be
+ * 'bowl_weak_cleared'. Immediate values, immortal values and the empty list 
+ * are never cleared.
+ * @return Either an exception (e.g. in case of a heap overflow) or the weak value.
+ */
+extern BowlResult bowl_weak(BowlStack stack, BowlValue target);
+
+/**
+ * The constructor for array values.
+ * In contrast to vectors, the elements of arrays are stored unboxed in a
+ * contiguous buffer. Since arrays are mutable, they are hashed and compared 
+ * by identity, which ensures that their cached hash never becomes stale when
+ * their elements change.
+ * @param stack The current stack of the environment.
+ * @param element The type of the elements.
+ * @param elements The elements which are copied into the array or 'NULL' to 
+ * initialize all elements with zeros.
+ * @param length The number of elements.
+ * @return Either an exception (e.g. in case of a heap overflow) or the array value.
+ */
+extern BowlResult bowl_array(BowlStack stack, BowlArrayElement element, void const *elements, u64 length);
+
+/**
+ * Returns the element of the provided array at the given index as a number.
+ * If immediate values are supported, this function never allocates. Elements
+ * of type 's64' whose magnitude exceeds 2^53 are rounded to the nearest number.
+ * Elements of type 'f64' keep their sign, so the results compare like any 
+ * other numbers: '-0.0' equals '0.0' and NaN equals NaN (see 
+ * 'bowl_value_equals').
+ * @param stack The current stack of the environment.
+ * @param array A value of type 'array'.
+ * @param index The index of the element.
+ * @return Either an exception (e.g. if the index is out of bounds) or the number value.
+ */
+extern BowlResult bowl_array_get(BowlStack stack, BowlValue array, u64 index);
+
+/**
+ * Stores the provided number in the given array at the specified index.
+ * The number must be exactly representable by the element type of the array.
+ * This function never allocates and no write barrier is required.
+ * 
+ * Immortal arrays (see 'BOWL_IS_IMMORTAL'), which includes the arrays of the 
+ * boot image and arrays in static memory, as well as arrays with the 
+ * 'BowlSharedFlag' may be read by several isolates at the same time and are 
+ * therefore read-only. Use 'bowl_value_clone' to obtain a private copy.
+ * @param stack The current stack of the environment.
+ * @param array A value of type 'array'.
+ * @param index The index of the element.
+ * @param number A value of type 'number'.
+ * @return Either an exception (e.g. if the index is out of bounds or the array
+ * is read-only) or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_array_set(BowlStack stack, BowlValue array, u64 index, BowlValue number);
+
+/**
+ * Returns the size of a single element of the provided type in bytes.
+ * @param element The type of the element.
+ * @return The size of the element in bytes.
+ */
+#define BOWL_ARRAY_ELEMENT_SIZE(element) ((element) == BowlUnsigned8Element ? sizeof(u8) : sizeof(u64))
+
+/**
+ * Returns the elements of the provided array. 
+ * The result must not be used across allocations, and the elements must not be
+ * modified through it if 'bowl_array_set' would reject the array.
+ * @param value A value of type 'array'.
+ * @param type The C type of the elements, which has to match the element type
+ * of the array (i.e. 'double', 's64' or 'u8').
+ * @return A pointer to the first element.
+ */
+#define BOWL_ARRAY_ELEMENTS(value, type) ((type *) (value)->array.bytes)
+
+/**
+ * The constructor for values of extension types.
+ * The data of the resulting value is initialized with zeros.
+ * @param stack The current stack of the environment.
+ * @param descriptor The registered descriptor of the extension type.
+ * @param length The length of the value's data in bytes.
+ * @return Either an exception (e.g. in case of a heap overflow) or the extension value.
+ */
+extern BowlResult bowl_extension(BowlStack stack, const BowlExtensionType *descriptor, u64 length);
+
+/**
+ * Checks whether the provided value is of the given extension type.
+ * @param value The value to check.
+ * @param expected The descriptor of the extension type.
+ * @return Whether or not the value is of the extension type.
+ */
+#define BOWL_IS_EXTENSION(value, expected) \
+    (BOWL_VALUE_TYPE(value) == BowlExtensionValue && (value)->extension.descriptor == (expected))
+
+/**
+ * Returns the data of the provided extension value. 
+ * The result must not be used across allocations.
+ * @param value A value of an extension type.
+ * @param type The C type of the data.
+ * @return A pointer to the data.
+ */
+#define BOWL_EXTENSION_DATA(value, type) ((type *) (value)->extension.bytes)
+
 /**
  * The constructor for exception values.
  * @param stack The current stack of the environment.
@@ -632,4 +1566,8 @@ extern BowlResult bowl_vector(BowlStack stack, BowlValue value, u64 const length
  */
 extern BowlResult bowl_exception(BowlStack stack, BowlValue cause, BowlValue message);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,330 @@
+#ifndef BIND_HPP
+#define BIND_HPP
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "api.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define _BOWL_BIND_FUNCTION_NAME __PRETTY_FUNCTION__
+#else
+#define _BOWL_BIND_FUNCTION_NAME __FUNCTION__
+#endif
+
+namespace bowl {
+
+    /**
+     * Describes how arguments of a C++ type are taken from the datastack.
+     * 
+     * Each specialization provides the expected value type ('type'), whether 
+     * this type is checked at all ('checked'), the type of any temporary storage
+     * which is required for the conversion ('Storage') and the conversion itself
+     * ('from'). Further specializations may be provided by modules.
+     * @tparam T The C++ type of the argument.
+     */
+    template <typename T>
+    struct Argument;
+
+    template <>
+    struct Argument<BowlValue> {
+        static constexpr BowlValueType type = BowlListValue;
+        static constexpr bool checked = false;
+        struct Storage {};
+        static BowlValue from(BowlValue value, Storage &) noexcept {
+            return value;
+        }
+    };
+
+    template <>
+    struct Argument<double> {
+        static constexpr BowlValueType type = BowlNumberValue;
+        static constexpr bool checked = true;
+        struct Storage {};
+        static double from(BowlValue value, Storage &) noexcept {
+            return BOWL_NUMBER_VALUE(value);
+        }
+    };
+
+    template <>
+    struct Argument<bool> {
+        static constexpr BowlValueType type = BowlBooleanValue;
+        static constexpr bool checked = true;
+        struct Storage {};
+        static bool from(BowlValue value, Storage &) noexcept {
+            return BOWL_BOOLEAN_VALUE(value);
+        }
+    };
+
+    /**
+     * Strings are viewed in place if they are stored using UTF-32. Otherwise,
+     * they are widened into a temporary buffer which lives as long as the call.
+     * Since a view in place refers to the heap, it is only valid until the next
+     * allocation (see 'bowl::_native').
+     */
+    template <>
+    struct Argument<std::u32string_view> {
+        static constexpr BowlValueType type = BowlStringValue;
+        static constexpr bool checked = true;
+        using Storage = std::u32string;
+        static std::u32string_view from(BowlValue value, Storage &storage) {
+            if (BOWL_STRING_ENCODING(value) == BowlUtf32Encoding) {
+                return std::u32string_view(reinterpret_cast<char32_t const *>(value->string.codepoints), value->string.length);
+            }
+            storage.resize(bowl_value_length(value));
+            bowl_string_widen(value, reinterpret_cast<u32 *>(&storage[0]));
+            return storage;
+        }
+    };
+
+    /**
+     * Describes how results of a C++ type are pushed onto the datastack.
+     * @tparam T The C++ type of the result.
+     */
+    template <typename T>
+    struct Result;
+
+    template <>
+    struct Result<BowlValue> {
+        static BowlValue push(BowlStack stack, BowlValue value) {
+            BOWL_STACK_PUSH_N(stack, 1, &value);
+            return NULL;
+        }
+    };
+
+    template <>
+    struct Result<BowlResult> {
+        static BowlValue push(BowlStack stack, BowlResult result) {
+            BOWL_STACK_PUSH_VALUE(stack, result);
+            return NULL;
+        }
+    };
+
+    template <>
+    struct Result<double> {
+        static BowlValue push(BowlStack stack, double value) {
+#if defined(BOWL_IMMEDIATE_VALUES)
+            return Result<BowlValue>::push(stack, BOWL_NUMBER(value));
+#else
+            return Result<BowlResult>::push(stack, bowl_number(stack, value));
+#endif
+        }
+    };
+
+    template <>
+    struct Result<bool> {
+        static BowlValue push(BowlStack stack, bool value) {
+#if defined(BOWL_IMMEDIATE_VALUES)
+            return Result<BowlValue>::push(stack, BOWL_BOOLEAN(value));
+#else
+            return Result<BowlResult>::push(stack, bowl_boolean(stack, value));
+#endif
+        }
+    };
+
+    template <>
+    struct Result<std::u32string> {
+        static BowlValue push(BowlStack stack, std::u32string const &value) {
+            return Result<BowlResult>::push(stack, bowl_string(stack, reinterpret_cast<u32 *>(const_cast<char32_t *>(value.data())), value.size()));
+        }
+    };
+
+    /**
+     * The view is copied before the string is allocated, since it may refer to
+     * the codepoints of an argument, which may be moved by the allocation.
+     */
+    template <>
+    struct Result<std::u32string_view> {
+        static BowlValue push(BowlStack stack, std::u32string_view value) {
+            return Result<std::u32string>::push(stack, std::u32string(value));
+        }
+    };
+
+    /**
+     * Returns the signature of the function which is generated for 'F'.
+     * @internal
+     */
+    template <auto F>
+    constexpr std::string_view _signature() noexcept {
+        return _BOWL_BIND_FUNCTION_NAME;
+    }
+
+    /**
+     * Extracts the name of the bound function from the provided signature. The 
+     * whole signature is returned if the name cannot be found.
+     * @internal
+     */
+    constexpr std::string_view _function_name(std::string_view signature) noexcept {
+        std::size_t begin = signature.find("F = ");
+        if (begin == std::string_view::npos) {
+            return signature;
+        }
+        begin += 4;
+        if (begin < signature.size() && signature[begin] == '&') {
+            ++begin;
+        }
+        std::size_t const end = signature.find_first_of(";]", begin);
+        return signature.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+    }
+
+    /**
+     * A null-terminated copy of a string which is created at compile time.
+     * @internal
+     */
+    template <std::size_t Length>
+    struct _Name {
+        char characters[Length + 1] = {};
+
+        constexpr explicit _Name(std::string_view name) noexcept {
+            for (std::size_t i = 0; i < Length; ++i) {
+                characters[i] = name[i];
+            }
+        }
+    };
+
+    /**
+     * The name of the bound C++ function, which is used in the messages of 
+     * exceptions in place of the name of the generated native function.
+     * @internal
+     */
+    template <auto F>
+    struct _FunctionName {
+        static constexpr std::string_view view = _function_name(_signature<F>());
+        static constexpr _Name<view.size()> name { view };
+    };
+
+    /**
+     * Decomposes the signature of a function which should be bound.
+     * @internal
+     */
+    template <typename F>
+    struct Signature;
+
+    template <typename R, typename... A>
+    struct Signature<R (*)(A...)> {
+        static constexpr bool stack = false;
+        using Return = R;
+        using Arguments = std::tuple<A...>;
+    };
+
+    template <typename R, typename... A>
+    struct Signature<R (*)(BowlStack, A...)> {
+        static constexpr bool stack = true;
+        using Return = R;
+        using Arguments = std::tuple<A...>;
+    };
+
+    /**
+     * Calls the function using the provided arguments and pushes its result.
+     * @internal
+     */
+    template <auto F, typename R, typename... A, std::size_t... I>
+    BowlValue _call(BowlStack stack, BowlValue const *values, std::tuple<A...> *, std::index_sequence<I...>) {
+        std::tuple<typename Argument<std::decay_t<A>>::Storage...> storage;
+        if constexpr (std::is_void<R>::value) {
+            if constexpr (Signature<decltype(F)>::stack) {
+                F(stack, Argument<std::decay_t<A>>::from(values[I], std::get<I>(storage))...);
+            } else {
+                F(Argument<std::decay_t<A>>::from(values[I], std::get<I>(storage))...);
+            }
+            return NULL;
+        } else if constexpr (Signature<decltype(F)>::stack) {
+            return Result<std::decay_t<R>>::push(stack, F(stack, Argument<std::decay_t<A>>::from(values[I], std::get<I>(storage))...));
+        } else {
+            return Result<std::decay_t<R>>::push(stack, F(Argument<std::decay_t<A>>::from(values[I], std::get<I>(storage))...));
+        }
+    }
+
+    /**
+     * Validates the types of all arguments and calls the function if they are valid.
+     * @internal
+     */
+    template <auto F, typename... A, std::size_t... I>
+    BowlValue _check(BowlStack stack, BowlValue const *values, std::tuple<A...> *arguments, std::index_sequence<I...> indices) {
+        constexpr std::size_t arity = sizeof...(A);
+        constexpr bool checked[arity + 1] = { Argument<std::decay_t<A>>::checked..., false };
+        constexpr BowlValueType types[arity + 1] = { Argument<std::decay_t<A>>::type..., BowlListValue };
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (checked[i] && BOWL_VALUE_TYPE(values[i]) != types[i]) {
+                return bowl_lazy_exception(stack, BowlIllegalTypeTemplate, bowl_value_type(values[i]), _FunctionName<F>::name.characters, bowl_type_name(types[i]));
+            }
+        }
+        stack->datastack->length -= arity;
+        try {
+            return _call<F, typename Signature<decltype(F)>::Return>(stack, values, arguments, indices);
+        } catch (std::bad_alloc const &) {
+            return bowl_exception_out_of_heap;
+        } catch (std::exception const &exception) {
+            return bowl_format_exception(stack, const_cast<char *>("%s in function '%s'"), exception.what(), _FunctionName<F>::name.characters).value;
+        } catch (...) {
+            return bowl_lazy_exception(stack, BowlUnknownExceptionTemplate, _FunctionName<F>::name.characters, nullptr, nullptr);
+        }
+    }
+
+    /**
+     * The native function which is generated for the provided C++ function.
+     * 
+     * The depth of the datastack is checked once and the types of all arguments
+     * are validated in a single pass before any argument is popped. That is, the 
+     * datastack remains unchanged if the arguments are invalid. The first argument
+     * of the C++ function corresponds to the deepest value on the datastack.
+     * 
+     * Arguments of type 'BowlValue' are not managed by the garbage collector 
+     * while the C++ function is running. They must be stored in a root (e.g. a 
+     * 'bowl::Local') if the function allocates. The same applies to arguments of
+     * type 'std::u32string_view', which may refer to the codepoints of a string
+     * in place and must be copied before any allocation.
+     * 
+     * C++ exceptions never leave the native function. The exception 
+     * 'std::bad_alloc' results in 'bowl_exception_out_of_heap' and all other 
+     * exceptions are converted into exception values.
+     * @tparam F The C++ function.
+     * @internal
+     */
+    template <auto F>
+    BowlValue _native(BowlStack stack) {
+        using Arguments = typename Signature<decltype(F)>::Arguments;
+        constexpr std::size_t arity = std::tuple_size<Arguments>::value;
+        BowlDatastack *const datastack = stack->datastack;
+        if (datastack->length < arity) {
+            return bowl_lazy_exception(stack, BowlStackUnderflowTemplate, _FunctionName<F>::name.characters, nullptr, nullptr);
+        }
+        BowlValue const *const values = datastack->elements + datastack->length - arity;
+        return _check<F>(stack, values, static_cast<Arguments *>(nullptr), std::make_index_sequence<arity>());
+    }
+
+    /**
+     * Generates a native function for the provided C++ function.
+     * 
+     * The C++ function may optionally take the current stack as its first 
+     * parameter. All other parameters as well as the return type must have a
+     * specialization of 'bowl::Argument' and 'bowl::Result' respectively.
+     * @tparam F The C++ function (e.g. 'double (*)(double, double)').
+     * @return The native function.
+     */
+    template <auto F>
+    constexpr BowlFunction bind() noexcept {
+        return &_native<F>;
+    }
+
+    /**
+     * Generates a function entry for the provided C++ function.
+     * @tparam F The C++ function.
+     * @param name The name of the function.
+     * @param documentation The documentation of the function or 'nullptr'.
+     * @return The function entry.
+     * @see bowl::bind
+     */
+    template <auto F>
+    BowlFunctionEntry entry(char const *name, char const *documentation = nullptr) noexcept {
+        return BowlFunctionEntry { const_cast<char *>(name), const_cast<char *>(documentation), bind<F>() };
+    }
+
+}
+
+#endif
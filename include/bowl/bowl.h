@@ -26,17 +26,256 @@ typedef enum {
     /** Indicates a value of type 'vector'. */
     BowlVectorValue    = 8,
     /** Indicates a value of type 'exception'. */
-    BowlExceptionValue = 9
+    BowlExceptionValue = 9,
+    /** 
+     * Indicates an internal node of a map. 
+     * 
+     * Values of this type are never visible to bowl code.
+     */
+    BowlMapNodeValue   = 10,
+    /** Indicates a value of type 'weak'. */
+    BowlWeakValue      = 11,
+    /** 
+     * Indicates a value of an extension type. 
+     * 
+     * The name of the type is defined by the descriptor of the value.
+     * @see BowlExtensionType
+     */
+    BowlExtensionValue = 12,
+    /** Indicates a value of type 'array'. */
+    BowlArrayValue     = 13
 } BowlValueType;
 
+/**
+ * An enumeration of all element types of arrays.
+ * @see bowl_array
+ */
+typedef enum {
+    /** Indicates elements of type 'double'. */
+    BowlFloat64Element   = 0,
+    /** Indicates elements of type 's64'. */
+    BowlSigned64Element  = 1,
+    /** Indicates elements of type 'u8'. */
+    BowlUnsigned8Element = 2
+} BowlArrayElement;
+
+/**
+ * An enumeration of all flags that may be set for bowl values.
+ * 
+ * Flags are combined using a bitwise or and are stored in the 'flags' field
+ * of a value.
+ */
+typedef enum {
+    /** 
+     * Indicates that a symbol is the canonical instance which is stored in the
+     * symbol table. That is, two interned symbols are equal if and only if they
+     * are identical.
+     */
+    BowlInternedFlag = 1 << 0,
+    /**
+     * Indicates that a value resides in the old generation of the heap. Values
+     * without this flag either reside in the nursery or outside of the heap.
+     */
+    BowlTenuredFlag = 1 << 1,
+    /**
+     * Indicates that a value of the old generation is part of the remembered
+     * set. That is, it may hold references to values in the nursery.
+     */
+    BowlRememberedFlag = 1 << 2,
+    /**
+     * Indicates that the codepoints of a string or symbol are stored using one
+     * byte per codepoint (i.e. all codepoints are less than 256).
+     * @see BowlStringEncoding
+     */
+    BowlLatin1Flag = 1 << 3,
+    /**
+     * Indicates that the codepoints of a string or symbol are stored using
+     * UTF-8.
+     * @see BowlStringEncoding
+     */
+    BowlUtf8Flag = 1 << 4,
+    /**
+     * Indicates that a string or symbol which is stored using UTF-8 carries a
+     * codepoint index.
+     * @see BOWL_UTF8_INDEX_STRIDE
+     */
+    BowlIndexedFlag = 1 << 5,
+    /**
+     * Indicates that a map is transient. That is, it is owned by a single 
+     * native function which mutates it in place.
+     * @see bowl_map_transient
+     */
+    BowlTransientFlag = 1 << 6,
+    /**
+     * Indicates that a value resides in static memory outside of the heap or
+     * in the immortal region, which may both be read-only. The garbage 
+     * collector neither relocates such a value nor writes to it.
+     */
+    BowlStaticFlag = 1 << 7,
+    /**
+     * Indicates that a value resides in a shared chunk. Shared chunks are
+     * immutable and may be referenced by several isolates at the same time.
+     * A shared chunk is released as soon as no isolate refers to it anymore.
+     * @see bowl_share
+     */
+    BowlSharedFlag = 1 << 8,
+    /**
+     * Indicates that the message of an exception has not been rendered yet.
+     * @see BowlExceptionTemplate
+     */
+    BowlLazyFlag = 1 << 9
+} BowlValueFlag;
+
+/**
+ * An enumeration of the message templates of lazy exceptions.
+ * 
+ * A lazy exception only stores the identifier of its template and the static
+ * strings which should be inserted into it. The message is rendered as soon 
+ * as it is required for the first time (see 'bowl_exception_message').
+ * @see bowl_exception_templates
+ */
+typedef enum {
+    /** The template "stack underflow in function '%s'". */
+    BowlStackUnderflowTemplate   = 0,
+    /** The template "argument of illegal type '%s' in function '%s' (expected type '%s')". */
+    BowlIllegalTypeTemplate      = 1,
+    /** The template "%s", which can be used for arbitrary static messages. */
+    BowlStaticMessageTemplate    = 2,
+    /** The template "unknown exception in function '%s'". */
+    BowlUnknownExceptionTemplate = 3
+} BowlExceptionTemplate;
+
+/**
+ * The maximum number of arguments of a lazy exception.
+ */
+#define BOWL_EXCEPTION_ARGUMENTS 3
+
+/**
+ * An enumeration of all representations of strings and symbols.
+ * 
+ * The representation of a value is determined by its flags. Values of type 
+ * 'string' or 'symbol' which have neither the 'BowlLatin1Flag' nor the 
+ * 'BowlUtf8Flag' set are stored using UTF-32.
+ */
+typedef enum {
+    /** Indicates that the codepoints are stored in 'string.codepoints' or 'symbol.codepoints'. */
+    BowlUtf32Encoding  = 0,
+    /** Indicates that the codepoints are stored in 'latin1.codepoints'. */
+    BowlLatin1Encoding = BowlLatin1Flag,
+    /** Indicates that the codepoints are stored in 'utf8.bytes'. */
+    BowlUtf8Encoding   = BowlUtf8Flag
+} BowlStringEncoding;
+
+/**
+ * The number of hash bits which are consumed by each level of a map.
+ */
+#define BOWL_MAP_NODE_BITS 5
+
+/**
+ * The maximum number of positions of a single map node.
+ */
+#define BOWL_MAP_NODE_WIDTH (1 << BOWL_MAP_NODE_BITS)
+
+/**
+ * The maximum depth of a map's trie including the level of collision nodes.
+ */
+#define BOWL_MAP_MAX_DEPTH ((64 + BOWL_MAP_NODE_BITS - 1) / BOWL_MAP_NODE_BITS + 1)
+
+/**
+ * The number of codepoints between two consecutive entries of the codepoint
+ * index of UTF-8 encoded strings and symbols.
+ * 
+ * The index is allocated along with the value directly after the bytes (aligned
+ * to 8 bytes) and consists of '(length - 1) / BOWL_UTF8_INDEX_STRIDE' entries 
+ * of type 'u64'. The i-th entry is the byte offset of the codepoint at index
+ * '(i + 1) * BOWL_UTF8_INDEX_STRIDE'.
+ */
+#define BOWL_UTF8_INDEX_STRIDE 64
+
 /**  
  * The type for all bowl values.
  * 
  * Since bowl values reside in the heap, this type is a pointer to the actual 
- * data structure.
+ * data structure. The only exceptions are immediate values.
+ * @see BOWL_IMMEDIATE_VALUES
  */
 typedef struct bowl_value *BowlValue;
 
+/**
+ * Indicates that numbers and booleans are encoded as immediate values.
+ *
+ * On 64-bit architectures a value of type 'BowlValue' is not necessarily a
+ * pointer into the heap. Numbers and booleans are encoded within the bits of
+ * the reference itself and thus never require an allocation:
+ *
+ * - References to heap values are 8-byte aligned and smaller than 2^49, since
+ *   user space addresses of all supported platforms are at most 48 bits wide.
+ * - Booleans are the unaligned constants 'BOWL_IMMEDIATE_FALSE' and
+ *   'BOWL_IMMEDIATE_TRUE'.
+ * - Numbers are stored as their IEEE 754 bit pattern offset by
+ *   'BOWL_IMMEDIATE_NUMBER_OFFSET'. Thus, every encoded number is at least
+ *   2^49. NaNs are canonicalized before they are encoded. All other numbers,
+ *   including '-0.0', keep their bit pattern.
+ *
+ * On any other architecture numbers and booleans are allocated in the heap.
+ * In both cases, the accessor macros of 'api.h' (e.g. 'BOWL_VALUE_TYPE' or
+ * 'BOWL_NUMBER_VALUE') should be used instead of dereferencing values directly.
+ */
+#if defined(OS_ARCHITECTURE_64)
+#define BOWL_IMMEDIATE_VALUES
+#endif
+
+/** The offset which is added to the bit pattern of immediate numbers. */
+#define BOWL_IMMEDIATE_NUMBER_OFFSET ((u64) 1 << 49)
+
+/** The immediate encoding of the boolean value 'false'. */
+#define BOWL_IMMEDIATE_FALSE ((BowlValue) (uintptr_t) 0x2)
+
+/** The immediate encoding of the boolean value 'true'. */
+#define BOWL_IMMEDIATE_TRUE ((BowlValue) (uintptr_t) 0xA)
+
+/**
+ * The type of the datastack.
+ * 
+ * The datastack is a contiguous and growable array of values which lives 
+ * outside of the heap. Thus, pushing and popping values never allocates any
+ * heap memory. The garbage collector treats the first 'length' elements as 
+ * roots and updates them in place.
+ * 
+ * Whenever bowl code inspects the datastack as a value, a list is materialized
+ * using 'bowl_datastack_to_list'.
+ */
+typedef struct bowl_datastack BowlDatastack;
+
+/**
+ * The actual data structure of the datastack.
+ * @see BowlDatastack
+ */
+struct bowl_datastack {
+    /** The number of values which are currently on the datastack. */
+    u64 length;
+    /** The number of values which fit into the datastack without growing it. */
+    u64 capacity;
+    /** 
+     * The values of the datastack. 
+     * 
+     * The bottom of the datastack is the first element and the top of the 
+     * datastack is the element at index 'length - 1'.
+     */
+    BowlValue *elements;
+};
+
+/**
+ * The type of an isolate.
+ * 
+ * An isolate is an independent instance of the virtual machine with its own
+ * heap, symbol table and registers. Different isolates may be used by different
+ * threads at the same time, but a single isolate must only be used by one 
+ * thread at a time.
+ * @see isolate.h
+ */
+typedef struct bowl_isolate BowlIsolate;
+
 /**
  * The type of a single stack frame of bowl.
  * 
@@ -52,8 +291,8 @@ typedef struct bowl_value *BowlValue;
  * 
  * The three registers may be used for arbitrary purposes as temporary variables. 
  * Any value that resides in one of these registers is managed by the garbage 
- * collector. Therefore, it is best to initialize them to 'NULL' when creating
- * new stack frames.
+ * collector (immediate values are simply left untouched). Therefore, it is best
+ * to initialize them to 'NULL' when creating new stack frames.
  * 
  * The references of the dictionary, the callstack and the datastack are managed
  * by the garbage collector as well. In general, they are references to registers
@@ -61,6 +300,10 @@ typedef struct bowl_value *BowlValue;
  * behavior of future instructions in the same scope. This is most likely to be 
  * desired when working with the datastack (e.g. retrieving arguments from the 
  * datastack and pushing result values onto it).
+ * 
+ * Every stack frame belongs to an isolate. If the reference to the isolate of a
+ * stack frame is 'NULL' (e.g. for empty stack frames), the isolate of its 
+ * predecessor is used instead.
  */
 typedef struct bowl_stack_frame BowlStackFrame;
 
@@ -84,7 +327,9 @@ struct bowl_stack_frame {
     /** The callstack of the current scope. */
     BowlValue *callstack;
     /** The datastack of the current scope. */
-    BowlValue *datastack;
+    BowlDatastack *datastack;
+    /** The isolate to which this stack frame belongs or 'NULL' if it is inherited. */
+    BowlIsolate *isolate;
 };
 
 /**
@@ -111,7 +356,8 @@ typedef BowlStackFrame *BowlStack;
     .registers = { (a), (b), (c) },\
     .dictionary = (stack)->dictionary,\
     .callstack = (stack)->callstack,\
-    .datastack = (stack)->datastack\
+    .datastack = (stack)->datastack,\
+    .isolate = (stack)->isolate\
 }
 
 /** 
@@ -124,7 +370,8 @@ typedef BowlStackFrame *BowlStack;
     .registers = { NULL, NULL, NULL },\
     .dictionary = NULL,\
     .callstack = NULL,\
-    .datastack = NULL\
+    .datastack = NULL,\
+    .isolate = NULL\
 }
 
 /**
@@ -151,6 +398,91 @@ typedef BowlValue (*BowlFunction)(BowlStack stack);
     typedef void *BowlLibraryHandle;
 #endif
 
+/**
+ * The interface of tracers.
+ * 
+ * A tracer accepts a slot of an extension value which holds a value and the
+ * context which was passed to the trace callback. The tracer may update the
+ * slot if the value is relocated. 
+ */
+typedef void (*BowlTracer)(BowlValue *, void *);
+
+/**
+ * The descriptor of an extension type.
+ * 
+ * Extension types allow native libraries to define opaque values (e.g. compiled
+ * regular expressions or native buffers) without encoding them as vectors or
+ * libraries. A descriptor is registered once per process (see 
+ * 'bowl_register_extension') and must live as long as the library is loaded, 
+ * which is usually achieved by a static variable. The runtime dispatches the
+ * generic operations on values (e.g. 'bowl_value_hash') to these callbacks. 
+ * Each callback may be 'NULL', in which case the default behavior described 
+ * below is used. In case of 'trace', this is only correct if the values of 
+ * the type do not refer to other values.
+ */
+typedef struct bowl_extension_type {
+    /** 
+     * The name of the type which is returned by 'bowl_value_type'. 
+     * 
+     * The name has to be unique among the extension types of the process. 
+     * Since descriptors are specific to a process, values of extension types
+     * cannot be written to boot images or heap snapshots.
+     */
+    const char *name;
+    /**
+     * Passes each slot of the provided value which holds a value to the tracer.
+     * This callback must neither allocate nor modify anything but the slots.
+     * It may be 'NULL' if the value does not refer to other values.
+     */
+    void (*trace)(BowlValue value, BowlTracer tracer, void *context);
+    /** 
+     * Returns the byte size of the value. 
+     * The default is 'sizeof(struct bowl_value)' plus its length in bytes.
+     */
+    u64 (*byte_size)(BowlValue value);
+    /** 
+     * Returns the hash of the value, which must not be '0'. 
+     * The default hash only depends on the identity of the value.
+     */
+    u64 (*hash)(BowlValue value);
+    /** 
+     * Tests whether two values of this type are equal.
+     * The default compares the values by identity.
+     */
+    bool (*equals)(BowlValue a, BowlValue b);
+    /**
+     * Computes a string representation of the value with the same contract as
+     * 'bowl_value_show_into'. The default is the name of the type in angle
+     * brackets.
+     */
+    u64 (*show)(BowlValue value, char *buffer, u64 capacity);
+    /** 
+     * Releases the native resources of the value after it has been collected. 
+     * 
+     * Finalize callbacks are queued and executed at safepoints along with the
+     * finalizers of the same collection (see 'bowl_finalizer_register'). A 
+     * dead value whose type has this callback is retained until the callback
+     * is executed and must not be stored anywhere else by it. Its memory is 
+     * reclaimed by the next collection.
+     * 
+     * Values which are moved by 'bowl_share' or 'bowl_task_group_join' are
+     * finalized once, as the moved value, and never on behalf of the abandoned
+     * original. Values moved into the immortal region are never finalized.
+     */
+    void (*finalize)(BowlStack stack, BowlValue value);
+    /**
+     * Initializes a copy which is created by 'bowl_value_clone', e.g. in order
+     * to duplicate a file descriptor. The bytes of the copy already contain the
+     * bytes of the original when the callback is executed.
+     * 
+     * The default keeps the copied bytes if the type has no 'finalize' 
+     * callback and fails with an exception otherwise, since both values would
+     * release the same resources.
+     * @return Either an exception or 'NULL' if no exception occurred.
+     */
+    BowlValue (*clone)(BowlStack stack, BowlValue original, BowlValue copy);
+} BowlExtensionType;
+
 /**
  * The actual data structure of a bowl value.
  * @see BowlValue
@@ -161,18 +493,24 @@ struct bowl_value {
      * @see BowlValueType
      */
     BowlValueType type;
+    /**
+     * The flags of this value.
+     * @see BowlValueFlag
+     */
+    u32 flags;
     /** 
      * The real location of this value.
      * 
      * This field is used by the garbage collector to mark the new location 
-     * of a value after it has been relocated by it.
+     * of a value after it has been relocated by it (e.g. after it has been
+     * promoted from the nursery to the old generation).
      */
     BowlValue location;
     /** 
      * The hash of this value.
      * 
      * A value of '0' indicates that the hash of this value is not yet 
-     * computed. 
+     * computed. The hash of interned symbols is always computed.
      */
     u64 hash;
 
@@ -181,7 +519,7 @@ struct bowl_value {
          * The data which is related to values of type 'symbol'.
          * 
          * Only access this member if the type of this value is equal to
-         * type 'symbol'.
+         * type 'symbol' and the symbol is stored using UTF-32.
          */
         struct {
             /** The length of this symbol. */
@@ -199,7 +537,8 @@ struct bowl_value {
          * The data which is related to values of type 'number'.
          * 
          * Only access this member if the type of this value is equal to
-         * type 'number'.
+         * type 'number' and 'BOWL_IMMEDIATE_VALUES' is not defined. Use
+         * 'BOWL_NUMBER_VALUE' instead.
          */
         struct {
             /** The IEEE 754 encoded value of this value with double precision. */
@@ -210,7 +549,8 @@ struct bowl_value {
          * The data which is related to values of type 'boolean'.
          * 
          * Only access this member if the type of this value is equal to
-         * type 'boolean'.
+         * type 'boolean' and 'BOWL_IMMEDIATE_VALUES' is not defined. Use
+         * 'BOWL_BOOLEAN_VALUE' instead.
          */
         struct {
             /** This value's boolean value. */
@@ -221,7 +561,7 @@ struct bowl_value {
          * The data which is related to values of type 'string'.
          * 
          * Only access this member if the type of this value is equal to
-         * type 'string'.
+         * type 'string' and the string is stored using UTF-32.
          */
         struct {
             /** The number of codepoints in this string. */
@@ -234,6 +574,46 @@ struct bowl_value {
             u32 codepoints[];
         } string;
 
+        /**
+         * The data which is related to strings and symbols with one byte per
+         * codepoint.
+         * 
+         * Only access this member if the type of this value is equal to either
+         * type 'string' or 'symbol' and the 'BowlLatin1Flag' is set.
+         */
+        struct {
+            /** The number of codepoints. */
+            u64 length;
+            /** 
+             * The codepoints of this value.
+             * 
+             * This array contains exactly 'length' codepoints and is allocated along
+             * with the instance of this value. 
+             */
+            u8 codepoints[];
+        } latin1;
+
+        /**
+         * The data which is related to UTF-8 encoded strings and symbols.
+         * 
+         * Only access this member if the type of this value is equal to either
+         * type 'string' or 'symbol' and the 'BowlUtf8Flag' is set.
+         */
+        struct {
+            /** The number of codepoints. */
+            u64 length;
+            /** The number of bytes. */
+            u64 size;
+            /** 
+             * The UTF-8 encoded codepoints of this value.
+             * 
+             * This array contains exactly 'size' bytes and is allocated along with
+             * the instance of this value. It is followed by the codepoint index if
+             * the 'BowlIndexedFlag' is set.
+             */
+            u8 bytes[];
+        } utf8;
+
         /**
          * The data which is related to values of type 'list'.
          * 
@@ -263,18 +643,61 @@ struct bowl_value {
         struct {
             /** The number of elements that this map contains. */
             u64 length;
-            /** The number of buckets that this map contains. */
-            u64 capacity;
             /**
-             * The buckets of this map.
+             * The root node of this map or 'NULL' if this map is empty.
              * 
-             * A bucket is represented as a list of where all odd elements (those
-             * with an even index) correspond to keys and all even elements (those
-             * with an odd index) correspond to values.
+             * A map is represented as a compressed hash array mapped trie. Each 
+             * level of the trie consumes 'BOWL_MAP_NODE_BITS' bits of the keys'
+             * hashes, starting with the least significant ones. Since all nodes 
+             * are immutable, unchanged subtrees are shared between maps.
              */
-            BowlValue buckets[];
+            BowlValue root;
+            /**
+             * The identifier of the transient session which owns this map or
+             * '0' if this map is persistent.
+             */
+            u64 owner;
         } map;
 
+        /**
+         * The data which is related to values of type 'map node'.
+         * 
+         * Only access this member if the type of this value is equal to
+         * type 'map node'.
+         */
+        struct {
+            /** 
+             * The bitmap of the positions which hold a key and a value. 
+             * 
+             * If neither this bitmap nor the 'nodemap' have any bit set, this
+             * node is a collision node. In this case, all slots are keys and 
+             * values whose keys have the same hash.
+             */
+            u32 datamap;
+            /** The bitmap of the positions which hold a child node. */
+            u32 nodemap;
+            /** The number of slots of this node. */
+            u64 length;
+            /**
+             * The identifier of the transient session which created this node.
+             * 
+             * A node may only be modified in place by a transient map with the
+             * same identifier. Identifiers are never reused, thus all nodes of
+             * a transient map become immutable as soon as it is persisted.
+             */
+            u64 owner;
+            /**
+             * The slots of this node.
+             * 
+             * The first '2 * popcount(datamap)' slots alternately contain a key
+             * and its value, ordered by their positions. They are followed by 
+             * 'popcount(nodemap)' child nodes, also ordered by their positions.
+             * This array contains exactly 'length' slots and is allocated along
+             * with the instance of this value.
+             */
+            BowlValue slots[];
+        } node;
+
         /**
          * The data which is related to values of type 'function'.
          * 
@@ -284,7 +707,13 @@ struct bowl_value {
         struct {
             /** The library value which contains this function or 'NULL' if there is none */
             BowlValue library;
-            /** The function pointer to the native function. */
+            /** 
+             * The function pointer to the native function. 
+             * 
+             * This field is 'NULL' for functions which were restored from a
+             * snapshot and have not been called yet.
+             * @see bowl_function_resolve
+             */
             BowlFunction function;
         } function;
 
@@ -295,7 +724,13 @@ struct bowl_value {
          * type 'library'.
          */
         struct {
-            /** The handle of the dynamic library. */
+            /** 
+             * The handle of the dynamic library. 
+             * 
+             * This field is 'NULL' for libraries which were restored from a
+             * snapshot and have not been used yet.
+             * @see bowl_library_resolve
+             */
             BowlLibraryHandle handle;
             /** The length of this library's name. */
             u64 length;
@@ -315,13 +750,107 @@ struct bowl_value {
             BowlValue elements[];
         } vector;
 
+        /**
+         * The data which is related to values of type 'weak'.
+         * 
+         * Only access this member if the type of this value is equal to
+         * type 'weak'.
+         */
+        struct {
+            /** 
+             * The value to which this weak value refers. 
+             * 
+             * A weak value does not keep its target alive. The garbage collector
+             * sets this field to 'bowl_weak_cleared' as soon as the target is 
+             * collected. Immediate and immortal targets are never collected.
+             */
+            BowlValue target;
+        } weak;
+
+        /**
+         * The data which is related to values of type 'array'.
+         * 
+         * Only access this member if the type of this value is equal to
+         * type 'array'.
+         */
+        struct {
+            /** The type of this array's elements. */
+            BowlArrayElement element;
+            /** The number of elements of this array. */
+            u64 length;
+            /** 
+             * The unboxed elements of this array, aligned to eight bytes. 
+             * 
+             * This array contains exactly 'length' elements of the element type
+             * and is allocated along with the instance of this value. Since it
+             * does not contain any values, arrays are never traced by the 
+             * garbage collector.
+             * @see BOWL_ARRAY_ELEMENTS
+             */
+            u8 bytes[];
+        } array;
+
+        /**
+         * The data which is related to values of extension types.
+         * 
+         * Only access this member if the type of this value is equal to
+         * 'BowlExtensionValue'.
+         */
+        struct {
+            /** The descriptor of this value's type. */
+            const BowlExtensionType *descriptor;
+            /** The length of this value's data in bytes. */
+            u64 length;
+            /** 
+             * The data of this value, which is aligned to eight bytes. 
+             * 
+             * This array contains exactly 'length' bytes and is allocated along
+             * with the instance of this value.
+             */
+            u8 bytes[];
+        } extension;
+
         struct {
             /** The exception which originally caused this one or 'NULL'. */
             BowlValue cause;
-            /** The message of this exception. */
-            BowlValue message;
+            union {
+                /** 
+                 * The message of this exception. 
+                 * 
+                 * This field is only valid if the 'BowlLazyFlag' is not set. Use
+                 * 'bowl_exception_message' otherwise.
+                 */
+                BowlValue message;
+                /** 
+                 * The template of the message (see 'BowlExceptionTemplate') if
+                 * the 'BowlLazyFlag' is set. 
+                 */
+                u64 template_id;
+            };
+            /** 
+             * The static strings which are inserted into the template of the
+             * message if this exception is lazy. 
+             * 
+             * This array contains exactly 'BOWL_EXCEPTION_ARGUMENTS' strings and
+             * is only allocated along with the instance of this value if it was
+             * created as a lazy exception. Once the message has been rendered, 
+             * the array is not used anymore.
+             */
+            const char *arguments[];
         } exception;
     };
 };
 
+#if defined(OS_ARCHITECTURE_64)
+/*
+ * Every value pays for the largest member of the union above. Thus, members
+ * of variable size have to be allocated along with the instance instead.
+ */
+#if defined(__cplusplus)
+static_assert(sizeof(struct bowl_value) == 48, "bowl values must not grow");
+#else
+_Static_assert(sizeof(struct bowl_value) == 48, "bowl values must not grow");
+#endif
+#endif
+
 #endif
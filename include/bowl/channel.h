@@ -0,0 +1,89 @@
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include "isolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The type of a channel.
+ * 
+ * A channel is a bounded queue which transfers values between isolates. It may
+ * be used by any number of sending and receiving threads at the same time and 
+ * is implemented as a lock-free ring buffer. 
+ * 
+ * Values are not copied into the heap of the receiving isolate. Instead, they
+ * are moved into a shared chunk once (see 'bowl_share') and the receiving 
+ * isolate refers to them in place. Values which already reside in a shared 
+ * chunk or in the immortal region are transferred without any copying at all.
+ */
+typedef struct bowl_channel BowlChannel;
+
+/**
+ * Creates a new channel.
+ * @param capacity The maximum number of values in the channel, which is rounded
+ * up to the next power of two.
+ * @return The channel or 'NULL' if there was not enough memory.
+ */
+extern BowlChannel *bowl_channel_create(u64 capacity);
+
+/**
+ * Releases the provided channel including any shared chunks which are only 
+ * referenced by values that have not been received yet.
+ * @param channel The channel to destroy.
+ */
+extern void bowl_channel_destroy(BowlChannel *channel);
+
+/**
+ * Tries to send the provided value using the given channel.
+ * The value is moved into a shared chunk unless it already resides in one or 
+ * is immortal.
+ * @param stack The current stack of the environment.
+ * @param channel The channel.
+ * @param value The value to send.
+ * @param sent A memory location where the information is stored whether the value
+ * was sent or whether the channel was full.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_channel_send(BowlStack stack, BowlChannel *channel, BowlValue value, bool *sent);
+
+/**
+ * Tries to receive a value from the provided channel.
+ * The received value is registered with the isolate of the stack, which keeps 
+ * its shared chunk alive as long as the value is reachable. This function 
+ * never allocates.
+ * @param stack The current stack of the environment.
+ * @param channel The channel.
+ * @param value A memory location where the received value is stored.
+ * @return Whether or not a value was received.
+ */
+extern bool bowl_channel_receive(BowlStack stack, BowlChannel *channel, BowlValue *value);
+
+/**
+ * Moves the graph of values which are reachable from the provided value into a
+ * new shared chunk.
+ * Values which already reside in a shared chunk or in the immortal region are 
+ * referenced instead of moved. References to the moved values within the heap
+ * of the stack's isolate are updated by the next collection. Finalizers which
+ * are registered for the moved values move into the chunk as well (see 
+ * 'bowl_finalizer_register').
+ * 
+ * Since symbol tables are specific to an isolate, interned symbols are copied
+ * into the chunk instead of being moved, and the copies do not carry the 
+ * 'BowlInternedFlag'. Thus, a received symbol is compared with the symbols of
+ * the receiving isolate by its codepoints (e.g. when it is used as a key of a
+ * map). Use 'bowl_symbol_intern' to obtain the canonical instance of the
+ * receiving isolate if pointer comparisons are desired.
+ * @param stack The current stack of the environment.
+ * @param value The value to share.
+ * @return Either the shared value or an exception.
+ */
+extern BowlResult bowl_share(BowlStack stack, BowlValue value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef HANDLE_HPP
+#define HANDLE_HPP
+
+#include <new>
+#include <type_traits>
+#include "isolate.h"
+
+namespace bowl {
+
+    /**
+     * A type tag which matches values of any type.
+     */
+    struct Value {
+        static constexpr bool matches(BowlValueType) noexcept {
+            return true;
+        }
+    };
+
+    /**
+     * A type tag which matches values of the provided type.
+     * @tparam Type The type of the values.
+     */
+    template <BowlValueType Type>
+    struct Typed {
+        static constexpr bool matches(BowlValueType type) noexcept {
+            return type == Type;
+        }
+    };
+
+    using Symbol = Typed<BowlSymbolValue>;
+    using List = Typed<BowlListValue>;
+    using Function = Typed<BowlNativeValue>;
+    using Map = Typed<BowlMapValue>;
+    using Boolean = Typed<BowlBooleanValue>;
+    using Number = Typed<BowlNumberValue>;
+    using String = Typed<BowlStringValue>;
+    using Library = Typed<BowlLibraryValue>;
+    using Vector = Typed<BowlVectorValue>;
+    using Exception = Typed<BowlExceptionValue>;
+    using Weak = Typed<BowlWeakValue>;
+    using Array = Typed<BowlArrayValue>;
+    using Extension = Typed<BowlExtensionValue>;
+
+    /**
+     * Checks whether the provided value matches the given type tag.
+     * @tparam T The type tag.
+     * @param value The value to check.
+     * @return Whether or not the value matches.
+     */
+    template <typename T>
+    inline bool is(BowlValue value) noexcept {
+        return T::matches(BOWL_VALUE_TYPE(value));
+    }
+
+    /**
+     * A scope which owns all roots that are created while it is alive.
+     * 
+     * The roots are stored in the handle blocks of the isolate (see 
+     * 'BOWL_HANDLE_BLOCK_SIZE'). Creating a root only bumps a pointer and
+     * leaving the scope releases all of them at once. Scopes must be strictly
+     * nested, which is guaranteed if they are only used as local variables.
+     */
+    class HandleScope {
+    public:
+        /**
+         * Opens a new scope for the isolate of the provided stack.
+         * @param stack The current stack of the environment.
+         */
+        explicit HandleScope(BowlStack stack) noexcept
+            : isolate_(bowl_stack_isolate(stack)),
+              top_(isolate_->handles_top),
+              limit_(isolate_->handles_limit) {}
+
+        HandleScope(HandleScope const &) = delete;
+        HandleScope &operator=(HandleScope const &) = delete;
+
+        /**
+         * Releases all roots which were created within this scope.
+         */
+        ~HandleScope() {
+            if (isolate_->handles_limit != limit_) {
+                bowl_handle_block_release(isolate_, top_, limit_);
+            } else {
+                isolate_->handles_top = top_;
+            }
+        }
+
+        /**
+         * Creates a new root which initially refers to the provided value.
+         * @param value The initial value.
+         * @return The slot of the root.
+         * @throws std::bad_alloc If a new handle block cannot be allocated.
+         */
+        BowlValue *root(BowlValue value) {
+            if (isolate_->handles_top == isolate_->handles_limit && !bowl_handle_block_extend(isolate_)) {
+                throw std::bad_alloc();
+            }
+            BowlValue *const slot = isolate_->handles_top++;
+            *slot = value;
+            return slot;
+        }
+
+    private:
+        BowlIsolate *isolate_;
+        BowlValue *top_;
+        BowlValue *limit_;
+    };
+
+    /**
+     * A reference to a value which is managed by the garbage collector.
+     * 
+     * A local refers to a slot of the enclosing handle scope, which is updated
+     * whenever the value is relocated. Hence, reading the value is a single
+     * pointer load, exactly like reading a register of a stack frame. A local 
+     * must not outlive its scope.
+     * @tparam T The type tag of the referenced value.
+     */
+    template <typename T = Value>
+    class Local {
+    public:
+        /**
+         * Creates a new root for the provided value within the given scope.
+         * @param scope The enclosing handle scope.
+         * @param value The value. 
+         */
+        Local(HandleScope &scope, BowlValue value) : slot_(scope.root(value)) {}
+
+        /**
+         * Allows any local to be used as a local of arbitrary type. Both locals
+         * share the same slot.
+         */
+        template <typename U, typename V = T, typename = typename std::enable_if<std::is_same<V, Value>::value>::type>
+        Local(Local<U> const &other) noexcept : slot_(other.slot()) {}
+
+        Local(Local const &) noexcept = default;
+
+        /**
+         * Replaces the referenced value by the value of the other local. Like
+         * assigning a value, this writes through the slot of this local rather
+         * than sharing the slot of the other one.
+         * @param other The other local.
+         * @return This local.
+         */
+        Local &operator=(Local const &other) noexcept {
+            *slot_ = *other.slot_;
+            return *this;
+        }
+
+        /**
+         * Replaces the referenced value without creating a new root. This affects
+         * all locals which share the slot of this local.
+         * @param value The new value.
+         * @return This local.
+         */
+        Local &operator=(BowlValue value) noexcept {
+            *slot_ = value;
+            return *this;
+        }
+
+        /**
+         * Returns the current location of the referenced value.
+         * The result must not be used across allocations.
+         * @return The value.
+         */
+        BowlValue get() const noexcept {
+            return *slot_;
+        }
+
+        operator BowlValue() const noexcept {
+            return *slot_;
+        }
+
+        BowlValue operator->() const noexcept {
+            return *slot_;
+        }
+
+        /**
+         * Returns the slot of this local.
+         * @return The slot.
+         */
+        BowlValue *slot() const noexcept {
+            return slot_;
+        }
+
+        /**
+         * Reinterprets this local as a local of another type without checking it.
+         * Use 'bowl::is' to check the type beforehand. Both locals share the same
+         * slot.
+         * @tparam U The type tag.
+         * @return The local.
+         */
+        template <typename U>
+        Local<U> as() const noexcept {
+            return Local<U>(slot_);
+        }
+
+    private:
+        template <typename> friend class Local;
+
+        explicit Local(BowlValue *slot) noexcept : slot_(slot) {}
+
+        BowlValue *slot_;
+    };
+
+    /**
+     * An owning wrapper of a persistent handle (see 'BowlPersistent').
+     * 
+     * In contrast to a local, a persistent may outlive any handle scope and is
+     * therefore suited to cache values in native libraries. Destroying the
+     * wrapper destroys the handle. A wrapper which was default-constructed,
+     * moved from or reset is empty. Empty wrappers may only be destroyed, 
+     * tested using 'empty', reset or assigned another persistent.
+     * 
+     * A persistent belongs to the isolate of the stack which was used to create
+     * it. Since the handles of an isolate are released by 'bowl_isolate_destroy',
+     * a persistent which is stored in a static variable of a native library 
+     * must be reset in 'bowl_module_finalize'. Otherwise, its destructor would
+     * access the released isolate when the process exits. Libraries which are
+     * loaded by several isolates need a separate persistent for each of them.
+     * @tparam T The type tag of the referenced value.
+     */
+    template <typename T = Value>
+    class Persistent {
+    public:
+        /**
+         * Creates an empty wrapper which does not own any handle.
+         */
+        Persistent() noexcept : isolate_(nullptr), handle_(nullptr) {}
+
+        /**
+         * Creates a new persistent handle which refers to the provided value.
+         * @param stack The current stack of the environment.
+         * @param value The value.
+         * @param kind The kind of the handle.
+         * @throws std::bad_alloc If the handle cannot be created.
+         */
+        Persistent(BowlStack stack, BowlValue value, BowlPersistentKind kind = BowlStrongPersistent)
+            : isolate_(bowl_stack_isolate(stack)),
+              handle_(bowl_persistent_create(isolate_, value, kind)) {
+            if (handle_ == nullptr) {
+                throw std::bad_alloc();
+            }
+        }
+
+        Persistent(Persistent const &) = delete;
+        Persistent &operator=(Persistent const &) = delete;
+
+        Persistent(Persistent &&other) noexcept : isolate_(other.isolate_), handle_(other.handle_) {
+            other.handle_ = nullptr;
+        }
+
+        Persistent &operator=(Persistent &&other) noexcept {
+            if (this != &other) {
+                reset();
+                isolate_ = other.isolate_;
+                handle_ = other.handle_;
+                other.handle_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~Persistent() {
+            reset();
+        }
+
+        /**
+         * Destroys the owned handle, if any, and makes this wrapper empty.
+         */
+        void reset() noexcept {
+            if (handle_ != nullptr) {
+                bowl_persistent_destroy(isolate_, handle_);
+                handle_ = nullptr;
+            }
+        }
+
+        /**
+         * Checks whether this wrapper does not own any handle.
+         * @return Whether or not this wrapper is empty.
+         */
+        bool empty() const noexcept {
+            return handle_ == nullptr;
+        }
+
+        /**
+         * Replaces the referenced value without creating a new handle.
+         * This wrapper must not be empty.
+         * @param value The new value.
+         * @return This persistent.
+         */
+        Persistent &operator=(BowlValue value) noexcept {
+            BOWL_PERSISTENT_SET(handle_, value);
+            return *this;
+        }
+
+        /**
+         * Returns the current location of the referenced value.
+         * The result must not be used across allocations.
+         * @return The value or 'NULL' if a weakly referenced value was collected.
+         */
+        BowlValue get() const noexcept {
+            return BOWL_PERSISTENT_GET(handle_);
+        }
+
+        operator BowlValue() const noexcept {
+            return BOWL_PERSISTENT_GET(handle_);
+        }
+
+        BowlValue operator->() const noexcept {
+            return BOWL_PERSISTENT_GET(handle_);
+        }
+
+        /**
+         * Creates a new local within the provided scope which refers to the 
+         * same value as this persistent.
+         * @param scope The enclosing handle scope.
+         * @return The local.
+         */
+        Local<T> local(HandleScope &scope) const {
+            return Local<T>(scope, BOWL_PERSISTENT_GET(handle_));
+        }
+
+    private:
+        BowlIsolate *isolate_;
+        BowlPersistent handle_;
+    };
+
+}
+
+#endif
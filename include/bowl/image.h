@@ -0,0 +1,232 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The magic bytes at the beginning of every boot image.
+ */
+#define BOWL_IMAGE_MAGIC "BOWLIMG"
+
+/**
+ * The version of the boot image format. Images of any other version are rejected.
+ */
+#define BOWL_IMAGE_VERSION ((u32) 2)
+
+/**
+ * The magic bytes at the beginning of every heap snapshot.
+ */
+#define BOWL_SNAPSHOT_MAGIC "BOWLSNP"
+
+/**
+ * An enumeration of the elements of the root value of a heap snapshot.
+ * 
+ * The root value of a snapshot is a vector which contains the registers of the
+ * snapshotted environment at the indices below.
+ */
+typedef enum {
+    /** The index of the dictionary. */
+    BowlSnapshotDictionary = 0,
+    /** The index of the callstack. */
+    BowlSnapshotCallstack  = 1,
+    /** The index of the datastack, which is stored as a list (see 'bowl_datastack_to_list'). */
+    BowlSnapshotDatastack  = 2,
+    /** The index of the list of all loaded library values. */
+    BowlSnapshotLibraries  = 3,
+    /** The number of elements of the root value. */
+    BowlSnapshotLength     = 4
+} BowlSnapshotRoot;
+
+/**
+ * The structure at the beginning of a boot image.
+ * 
+ * A boot image is a verbatim copy of a closed graph of values, laid out as if
+ * it was mapped at the address 'base'. This address lies at the beginning of
+ * the immortal region, which is reserved at the same address by every process
+ * of the same build. Thus, the image is usually mapped at its preferred 
+ * address and used in place. Apart from the values in the function table, 
+ * which are resolved once while the image is loaded, no value is touched and 
+ * the image is read-only afterwards. Only if the address is not available, 
+ * the image is mapped privately (i.e. copy-on-write) at any other address and
+ * the references listed in the relocation table are adjusted once.
+ * 
+ * All values are stored with their hashes already computed. Hence, using them
+ * as keys of a map never writes to the image. Symbols of the image keep the 
+ * 'BowlInternedFlag', since every isolate enters them into its symbol table
+ * when it is created (see 'bowl_isolate_create').
+ * 
+ * The fields of this structure are followed by the values and the tables, 
+ * which are all referenced by their offsets relative to the beginning of the 
+ * image.
+ */
+typedef struct {
+    /** The magic bytes 'BOWL_IMAGE_MAGIC' including the terminating null character. */
+    u8 magic[8];
+    /** The version of the format (i.e. 'BOWL_IMAGE_VERSION'). */
+    u32 version;
+    /** The size of a reference in bytes, which must match 'sizeof(BowlValue)'. */
+    u32 reference_size;
+    /** The preferred address at which the image should be mapped. */
+    u64 base;
+    /** The size of the image in bytes. */
+    u64 size;
+    /** The offset of the root value (e.g. the dictionary). */
+    u64 root;
+    /** The offset of the relocation table. */
+    u64 relocations;
+    /** The number of entries in the relocation table. */
+    u64 relocations_length;
+    /** The offset of the function table. */
+    u64 functions;
+    /** The number of entries in the function table. */
+    u64 functions_length;
+} BowlImageHeader;
+
+/**
+ * An entry of the relocation table of a boot image. 
+ * 
+ * Each entry refers to a reference within the image which must be adjusted if
+ * the image is not mapped at its preferred address. Immediate values and the 
+ * empty list are never listed.
+ */
+typedef struct {
+    /** The offset of the reference within the image. */
+    u64 offset;
+} BowlImageRelocation;
+
+/**
+ * An entry of the function table of a boot image or heap snapshot.
+ * 
+ * Function pointers and library handles are specific to a process. Thus, the 
+ * values of type 'function' and 'library' are resolved by name whenever a boot
+ * image is loaded, which only writes to the pages that contain these values. 
+ * This happens before the image is made read-only and shared by the isolates.
+ * The values of a heap snapshot are resolved lazily instead (see 
+ * 'bowl_snapshot_restore').
+ * 
+ * Libraries are reopened using their path. Native functions are usually not
+ * exported by their libraries, thus they are looked up by the name of their 
+ * entry in the table 'bowl_module_entries' of their library.
+ * Functions which do not belong to a library are looked up in the entries of
+ * the runtime itself.
+ */
+typedef struct {
+    /** The offset of the value of type 'function' or 'library'. */
+    u64 value;
+    /** 
+     * The offset of the library value to which the native function belongs.
+     * This is '0' for values of type 'library' and for functions which belong
+     * to the runtime.
+     */
+    u64 library;
+    /** 
+     * The offset of the null-terminated name of the function's entry. This is
+     * '0' for values of type 'library'.
+     */
+    u64 name;
+} BowlImageFunction;
+
+/**
+ * Maps the boot image at the provided path into the immortal region.
+ * There is at most one boot image per process, which is shared by all of its
+ * isolates. If the image at the provided path is already mapped, its root value
+ * is returned without mapping it again. Loading a different image fails.
+ * @param stack The current stack of the environment.
+ * @param path The path to the boot image.
+ * @return Either the root value of the image or an exception (e.g. if the file is
+ * not a valid boot image or another boot image is already mapped).
+ */
+extern BowlResult bowl_image_load(BowlStack stack, char *path);
+
+/**
+ * Writes the graph of values which are reachable from the provided root value
+ * into a new boot image at the provided path.
+ * The hashes of all values are computed before they are written.
+ * @param stack The current stack of the environment.
+ * @param path The path of the boot image.
+ * @param root The root value of the image (e.g. the dictionary).
+ * @return Either an exception (e.g. if a value of an extension type is 
+ * reachable from the root value) or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_image_write(BowlStack stack, char *path, BowlValue root);
+
+/**
+ * Writes the current state of the environment into a new heap snapshot at the
+ * provided path.
+ * 
+ * A heap snapshot uses the same format as a boot image (except for its magic
+ * bytes) and contains the dictionary, the callstack, the datastack and all 
+ * library values which are currently loaded. In contrast to boot images, the
+ * functions and libraries of a snapshot are not resolved when it is restored.
+ * 
+ * Values of extension types refer to descriptors and native resources which 
+ * are specific to the process (see 'BowlExtensionType'). Thus, writing fails
+ * if any of them is reachable from the environment, including values which 
+ * are only referenced by the datastack or by a library. Modules which use 
+ * extension types have to release or convert these values before a snapshot
+ * is written and recreate them in 'bowl_module_restore'.
+ * @param stack The current stack of the environment.
+ * @param path The path of the heap snapshot.
+ * @return Either an exception (e.g. if a value of an extension type is 
+ * reachable) or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_snapshot_write(BowlStack stack, char *path);
+
+/**
+ * Restores the heap snapshot at the provided path into the current environment.
+ * 
+ * In contrast to a boot image, the snapshot is neither mapped into the immortal
+ * region nor shared. It is mapped privately (i.e. copy-on-write) at any address
+ * into the old generation of the stack's isolate, relocated and owned by that
+ * isolate from then on. The dictionary, the callstack and the datastack of the
+ * environment are replaced by the ones of the snapshot. 
+ * 
+ * Libraries are neither reopened nor initialized again. Instead, the handle of
+ * a library is opened using its path as soon as one of its functions is called
+ * for the first time. At this point, 'bowl_module_restore' is executed instead
+ * of 'bowl_module_initialize', since the functions of the library are already
+ * part of the restored dictionary. Modules which keep state outside of the 
+ * heap (e.g. persistent handles or extension types) have to recreate it in 
+ * that function. Since each isolate restores its own copy of a snapshot, 
+ * resolving its libraries and functions only writes to memory which is 
+ * private to the isolate. A snapshot never contains values of extension types
+ * (see 'bowl_snapshot_write').
+ * @param stack The current stack of the environment.
+ * @param path The path to the heap snapshot.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+extern BowlValue bowl_snapshot_restore(BowlStack stack, char *path);
+
+/**
+ * Ensures that the handle of the provided library value is opened.
+ * If the library was restored from a heap snapshot, its 'bowl_module_restore'
+ * function is executed once the handle has been opened.
+ * @param stack The current stack of the environment.
+ * @param library A value of type 'library'.
+ * @return Either an exception (e.g. if the library cannot be opened) or 'NULL'
+ * if no exception occurred.
+ */
+extern BowlValue bowl_library_resolve(BowlStack stack, BowlValue library);
+
+/**
+ * Ensures that the function pointer of the provided function value is resolved.
+ * Native code which calls the function pointer of a function value directly must
+ * call this function beforehand if the function pointer is 'NULL'. The library 
+ * of the function is resolved first, after which the function pointer is 
+ * looked up by name in its table of entries (see 'BowlImageFunction').
+ * @param stack The current stack of the environment.
+ * @param function A value of type 'function'.
+ * @return Either an exception (e.g. if the function cannot be found) or 'NULL'
+ * if no exception occurred.
+ */
+extern BowlValue bowl_function_resolve(BowlStack stack, BowlValue function);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef ISOLATE_H
+#define ISOLATE_H
+
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The settings of an isolate.
+ * @see BowlIsolate
+ */
+typedef struct {
+    /** 
+     * The path to the boot image. 
+     * 
+     * The boot image is shared by all isolates of a process. Hence, this path
+     * has to be equal to the boot path of all other isolates of the process
+     * (see 'bowl_image_load').
+     */
+    const char *boot_path;
+    /** The path to the kernel library. */
+    const char *kernel_path;
+    /** The level of verbosity. */
+    u64 verbosity;
+    /** The size of the isolate's nursery in bytes. */
+    u64 nursery_size;
+} BowlIsolateSettings;
+
+/**
+ * The actual data structure of an isolate.
+ * 
+ * Each isolate owns a heap whose nursery serves as the allocation buffer of 
+ * the thread that currently uses the isolate. That is, allocations bump the 
+ * pointer 'allocation_top' without any synchronization and only enter the
+ * runtime if 'allocation_limit' is reached. Only the members below are part of
+ * the public interface.
+ * @see BowlIsolate
+ */
+struct bowl_isolate {
+    /** The settings which were used to create this isolate. */
+    BowlIsolateSettings settings;
+    /** The next free byte of the allocation buffer. */
+    u8 *allocation_top;
+    /** The first byte after the allocation buffer. */
+    u8 *allocation_limit;
+    /** The dictionary register of this isolate. */
+    BowlValue dictionary;
+    /** The callstack register of this isolate. */
+    BowlValue callstack;
+    /** The datastack register of this isolate. */
+    BowlDatastack datastack;
+    /** The next free slot of the current handle block. */
+    BowlValue *handles_top;
+    /** The first slot after the current handle block. */
+    BowlValue *handles_limit;
+};
+
+/**
+ * The number of slots of a single handle block.
+ * 
+ * Handle blocks are used to store an arbitrary number of roots (e.g. by the 
+ * scopes of 'handle.hpp'). The slots of all handle blocks of an isolate form a
+ * stack whose top is 'handles_top'. All slots below the top are managed by the
+ * garbage collector. Since handle blocks are never moved, pointers to their 
+ * slots remain valid until they are released.
+ */
+#define BOWL_HANDLE_BLOCK_SIZE 256
+
+/**
+ * Returns the settings which are defined by the CLI (i.e. 
+ * 'bowl_settings_boot_path', 'bowl_settings_kernel_path', 
+ * 'bowl_settings_verbosity' and 'bowl_settings_nursery_size').
+ * @return The default settings.
+ */
+extern BowlIsolateSettings bowl_isolate_default_settings(void);
+
+/**
+ * Creates a new isolate including its heap and loads its boot image and kernel.
+ * The boot image is only mapped by the first isolate of the process. All other
+ * isolates use the same mapping. Before the kernel is loaded, the symbol table
+ * of the new isolate is seeded with all interned symbols of the boot image. 
+ * Thus, the symbols of the image are the canonical instances in every isolate
+ * and names of the image are found in the dictionary by identity.
+ * @param settings The settings of the isolate or 'NULL' to use the default 
+ * settings.
+ * @return The isolate or 'NULL' if there was not enough memory, the boot image 
+ * or kernel could not be loaded or the boot path differs from the one of the 
+ * process.
+ */
+extern BowlIsolate *bowl_isolate_create(BowlIsolateSettings const *settings);
+
+/**
+ * Finalizes all libraries of the provided isolate and releases its heap as well
+ * as its persistent handles.
+ * @param isolate The isolate to destroy.
+ */
+extern void bowl_isolate_destroy(BowlIsolate *isolate);
+
+/**
+ * Appends a new handle block to the handles of the provided isolate and makes
+ * it the current handle block.
+ * @param isolate The isolate.
+ * @return Whether or not there was enough memory.
+ */
+extern bool bowl_handle_block_extend(BowlIsolate *isolate);
+
+/**
+ * Releases all handle blocks which were appended after the handle block that
+ * ends at the provided limit and resets the top of the handles.
+ * @param isolate The isolate.
+ * @param top The new top of the handles.
+ * @param limit The end of the handle block which contains the new top.
+ */
+extern void bowl_handle_block_release(BowlIsolate *isolate, BowlValue *top, BowlValue *limit);
+
+/**
+ * An enumeration of the kinds of persistent handles.
+ * @see BowlPersistent
+ */
+typedef enum {
+    /** The referenced value is kept alive by the handle. */
+    BowlStrongPersistent = 0,
+    /** 
+     * The referenced value is not kept alive by the handle. As soon as the value
+     * is collected, the handle refers to 'NULL'.
+     */
+    BowlWeakPersistent   = 1
+} BowlPersistentKind;
+
+/**
+ * A persistent handle which refers to a value across an arbitrary number of 
+ * allocations and calls.
+ * 
+ * Persistent handles are slots of a table which is owned by the isolate and 
+ * updated by the garbage collector. In contrast to handle blocks, they are not
+ * bound to any scope and may therefore be used by native libraries to cache 
+ * values between calls (e.g. in their 'bowl_module_initialize' function). The
+ * slots of the table are never moved and released slots are linked into a 
+ * free list, so both creating and destroying a handle take constant time.
+ * Reading a handle is a single pointer load (see 'BOWL_PERSISTENT_GET'). Since 
+ * the table is not part of the heap, storing a value into a handle does not 
+ * require a write barrier.
+ */
+typedef BowlValue *BowlPersistent;
+
+/**
+ * Creates a new persistent handle which refers to the provided value.
+ * @param isolate The isolate which owns the value.
+ * @param value The value or 'NULL'.
+ * @param kind The kind of the handle.
+ * @return The handle or 'NULL' if there was not enough memory.
+ */
+extern BowlPersistent bowl_persistent_create(BowlIsolate *isolate, BowlValue value, BowlPersistentKind kind);
+
+/**
+ * Destroys the provided persistent handle. The handle must not be used afterwards.
+ * All remaining handles of an isolate are destroyed by 'bowl_isolate_destroy'.
+ * @param isolate The isolate which owns the handle.
+ * @param handle The handle or 'NULL'.
+ */
+extern void bowl_persistent_destroy(BowlIsolate *isolate, BowlPersistent handle);
+
+/**
+ * Returns the current location of the value to which the provided persistent 
+ * handle refers. The result must not be used across allocations.
+ * @param handle The persistent handle.
+ * @return The value or 'NULL' if a weakly referenced value was collected.
+ */
+#define BOWL_PERSISTENT_GET(handle) (*(handle))
+
+/**
+ * Replaces the value to which the provided persistent handle refers. The kind
+ * of the handle is retained.
+ * @param handle The persistent handle.
+ * @param value The new value or 'NULL'.
+ */
+#define BOWL_PERSISTENT_SET(handle, value) (*(handle) = (value))
+
+/**
+ * Creates the initial stack frame of the provided isolate. 
+ * The dictionary, the callstack and the datastack of the stack frame refer to 
+ * the registers of the isolate.
+ * @param owner The isolate.
+ * @return A designated initializer for the type 'BowlStackFrame'.
+ */
+#define BOWL_ISOLATE_STACK_FRAME(owner) {\
+    .previous = NULL,\
+    .registers = { NULL, NULL, NULL },\
+    .dictionary = &(owner)->dictionary,\
+    .callstack = &(owner)->callstack,\
+    .datastack = &(owner)->datastack,\
+    .isolate = (owner)\
+}
+
+/**
+ * The isolate which is used by stacks that do not belong to any isolate.
+ * 
+ * Stack frames which were created without 'BOWL_ISOLATE_STACK_FRAME' (e.g. by
+ * embedders which predate isolates) do not refer to an isolate at all. Such
+ * stacks belong to this isolate, which is created by the runtime on startup.
+ */
+extern BowlIsolate *bowl_default_isolate;
+
+/**
+ * Returns the isolate to which the provided stack belongs.
+ * The frames of the stack are searched for the first one which refers to an
+ * isolate. If there is none, the stack belongs to 'bowl_default_isolate'.
+ * @param stack The current stack of the environment.
+ * @return The isolate.
+ */
+static inline BowlIsolate *bowl_stack_isolate(BowlStack stack) {
+    while (stack != NULL && stack->isolate == NULL) {
+        stack = stack->previous;
+    }
+    return stack != NULL ? stack->isolate : bowl_default_isolate;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "bowl.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * The interface of module functions.
  * 
@@ -30,4 +34,23 @@ BowlValue bowl_module_initialize(BowlStack stack, BowlValue library);
  */
 BowlValue bowl_module_finalize(BowlStack stack, BowlValue library);
 
+/**
+ * This function may optionally be implemented by the module author.
+ * It is executed instead of 'bowl_module_initialize' as soon as the library is
+ * reopened after it was restored from a heap snapshot (see 
+ * 'bowl_snapshot_restore'). Since the dictionary was restored along with the
+ * registered functions, it must not register any functions. Instead, it 
+ * should recreate the state of the module outside of the heap, e.g. its 
+ * persistent handles and extension types.
+ * @param stack The stack of the current environment.
+ * @param library The library value which represents this module.
+ * @return Either an exception or 'NULL' if no exception occurred.
+ */
+BowlValue bowl_module_restore(BowlStack stack, BowlValue library);
+
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
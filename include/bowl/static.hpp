@@ -0,0 +1,130 @@
+#ifndef STATIC_HPP
+#define STATIC_HPP
+
+#include <cstddef>
+#include "api.h"
+
+namespace bowl {
+
+    /**
+     * Computes the hash of a string or symbol with the provided codepoints at
+     * compile time.
+     * @param codepoints The codepoints of the string or symbol.
+     * @param length The number of codepoints.
+     * @return The hash as computed by 'bowl_value_hash'.
+     */
+    template <typename Codepoint>
+    constexpr u64 hash(Codepoint const *codepoints, std::size_t length) {
+        u64 hash = BOWL_HASH_OFFSET_BASIS;
+        for (std::size_t i = 0; i < length; ++i) {
+            hash = (hash ^ static_cast<u32>(codepoints[i])) * BOWL_HASH_PRIME;
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    /**
+     * A string or symbol whose codepoints and hash are computed at compile time.
+     * 
+     * The layout of this structure matches the layout of 'struct bowl_value'.
+     * Instances should be declared 'static constexpr' so that they reside in
+     * read-only memory. Since their hash is already computed and the garbage
+     * collector does not touch values with the 'BowlStaticFlag', they are never
+     * written to.
+     * 
+     * Values which are created on basis of C string literals are stored with one
+     * byte per codepoint, while values which are created on basis of unicode 
+     * string literals are stored using UTF-32.
+     * @tparam Codepoint The type of a single codepoint (either 'u8' or 'u32').
+     * @tparam Length The number of codepoints.
+     */
+    template <typename Codepoint, std::size_t Length>
+    struct StaticValue {
+        /** @see bowl_value::type */
+        BowlValueType type;
+        /** @see bowl_value::flags */
+        u32 flags;
+        /** @see bowl_value::location */
+        BowlValue location;
+        /** @see bowl_value::hash */
+        u64 hash;
+        /** The number of codepoints. */
+        u64 length;
+        /** The codepoints (there is always at least one element to keep the array well-formed). */
+        Codepoint codepoints[Length == 0 ? 1 : Length];
+
+        /**
+         * Creates a new static value on basis of the provided string literal. 
+         * @param type Either 'BowlStringValue' or 'BowlSymbolValue'.
+         * @param literal The null-terminated string literal.
+         */
+        template <typename Character>
+        constexpr StaticValue(BowlValueType type, Character const (&literal)[Length + 1])
+            : type(type), 
+              flags(BowlStaticFlag | (sizeof(Codepoint) == 1 ? BowlLatin1Flag : 0)),
+              location(nullptr),
+              hash(bowl::hash(literal, Length)),
+              length(Length),
+              codepoints{} {
+            for (std::size_t i = 0; i < Length; ++i) {
+                if (sizeof(Character) == 1 && static_cast<unsigned char>(literal[i]) > 0x7F) {
+                    throw "static C strings and symbols must only contain ASCII characters";
+                }
+                codepoints[i] = static_cast<Codepoint>(literal[i]);
+            }
+        }
+
+        /**
+         * Returns this static value as an ordinary bowl value.
+         * @return The bowl value.
+         */
+        BowlValue value() const noexcept {
+            return reinterpret_cast<BowlValue>(const_cast<StaticValue *>(this));
+        }
+    };
+
+    /**
+     * Creates a static string on basis of the provided C string literal, which 
+     * must only contain ASCII characters.
+     * @param literal The C string literal.
+     * @return The static string.
+     */
+    template <std::size_t Size>
+    constexpr StaticValue<u8, Size - 1> static_string(char const (&literal)[Size]) {
+        return StaticValue<u8, Size - 1>(BowlStringValue, literal);
+    }
+
+    /**
+     * Creates a static string on basis of the provided unicode string literal.
+     * @param literal The unicode string literal (e.g. U"...").
+     * @return The static string.
+     */
+    template <std::size_t Size>
+    constexpr StaticValue<u32, Size - 1> static_string(char32_t const (&literal)[Size]) {
+        return StaticValue<u32, Size - 1>(BowlStringValue, literal);
+    }
+
+    /**
+     * Creates a static symbol on basis of the provided C string literal, which 
+     * must only contain ASCII characters. Static symbols are not interned.
+     * @param literal The C string literal.
+     * @return The static symbol.
+     */
+    template <std::size_t Size>
+    constexpr StaticValue<u8, Size - 1> static_symbol(char const (&literal)[Size]) {
+        return StaticValue<u8, Size - 1>(BowlSymbolValue, literal);
+    }
+
+    /**
+     * Creates a static symbol on basis of the provided unicode string literal.
+     * Static symbols are not interned.
+     * @param literal The unicode string literal (e.g. U"...").
+     * @return The static symbol.
+     */
+    template <std::size_t Size>
+    constexpr StaticValue<u32, Size - 1> static_symbol(char32_t const (&literal)[Size]) {
+        return StaticValue<u32, Size - 1>(BowlSymbolValue, literal);
+    }
+
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include "isolate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The number of worker threads of the task pool as defined by the CLI. The value
+ * '0' indicates that the number of worker threads equals the number of cores.
+ */
+extern u64 bowl_settings_task_workers;
+
+/**
+ * The interface of a task.
+ * 
+ * A task is executed by a worker thread of the task pool using a stack that
+ * belongs to the worker's scratch isolate. That is, all values which are 
+ * allocated by the task reside in the scratch arena of the worker, which is
+ * reset as soon as the results of the task's group have been handed off.
+ * 
+ * A task may read values of the submitting isolate (e.g. by passing them as
+ * the argument), since the submitting isolate does not allocate until the 
+ * group is joined. However, a task must not modify them. The only exception
+ * is the hash of a value, which is cached by 'bowl_value_hash' using relaxed
+ * atomic operations. Since all threads compute the same hash, concurrent calls
+ * of 'bowl_value_hash' for the same value are safe.
+ * @param stack The stack of the worker's scratch isolate.
+ * @param argument The argument that was passed to 'bowl_task_submit'.
+ * @return Either the result of the task or an exception.
+ */
+typedef BowlResult (*BowlTask)(BowlStack stack, void *argument);
+
+/**
+ * The type of a task group.
+ * 
+ * A task group collects the tasks which are submitted by a single native 
+ * function. Each worker of the task pool owns a double-ended queue of tasks.
+ * Workers pop tasks from the bottom of their own queue and steal tasks from the
+ * top of the queues of other workers whenever their own queue is empty.
+ */
+typedef struct bowl_task_group BowlTaskGroup;
+
+/**
+ * Creates a new task group. The task pool is started on first use.
+ * @param stack The current stack of the environment.
+ * @return The task group or 'NULL' if there was not enough memory.
+ */
+extern BowlTaskGroup *bowl_task_group_create(BowlStack stack);
+
+/**
+ * Submits the provided task to the given task group.
+ * @param group The task group.
+ * @param task The task to execute.
+ * @param argument The argument which is passed to the task.
+ * @return Whether or not the task was submitted. This is 'false' if there was not
+ * enough memory.
+ */
+extern bool bowl_task_submit(BowlTaskGroup *group, BowlTask task, void *argument);
+
+/**
+ * Waits for all tasks of the provided group to complete and releases the group.
+ * The calling thread executes tasks of the group while it is waiting. These
+ * tasks are executed using the stack of a scratch isolate which belongs to the
+ * calling thread, never using the provided stack. Thus, the isolate of the 
+ * stack neither allocates nor collects until all tasks have completed.
+ * 
+ * The results are handed off to the isolate of the stack by copying all values 
+ * which reside in the scratch arenas of the workers into its heap. Values of
+ * the isolate itself which are referenced by the results are not copied. The
+ * finalizers of the copied values are transferred to their copies when the
+ * scratch arenas are reset, so they are not executed on behalf of a worker.
+ * @param stack The current stack of the environment.
+ * @param group The task group.
+ * @return Either a vector which contains the results in the order in which the
+ * tasks were submitted or the exception of the first task that failed.
+ */
+extern BowlResult bowl_task_group_join(BowlStack stack, BowlTaskGroup *group);
+
+/**
+ * Abandons the provided group and releases it.
+ * Tasks which have not been started yet are discarded. This function waits for
+ * all running tasks of the group to complete and discards their results. It 
+ * never allocates in the isolate of the submitting stack and is therefore
+ * suited for error paths.
+ * 
+ * Every group has to be either joined or cancelled before the submitting 
+ * isolate allocates again, since its tasks may still read values of that 
+ * isolate. This includes paths on which an exception is returned.
+ * @param group The task group.
+ */
+extern void bowl_task_group_cancel(BowlTaskGroup *group);
+
+/**
+ * Applies the provided function to all elements of a vector in parallel.
+ * The elements are partitioned into chunks, each of which is processed by a
+ * single task.
+ * @param stack The current stack of the environment.
+ * @param vector A value of type 'vector'.
+ * @param function The function which is applied to each element. It is called 
+ * with the stack of a worker's scratch isolate.
+ * @return Either a vector of the results or the first exception.
+ */
+extern BowlResult bowl_vector_parallel_map(BowlStack stack, BowlValue vector, BowlResult (*function)(BowlStack stack, BowlValue element));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
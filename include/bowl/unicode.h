@@ -9,6 +9,10 @@
 
 #include "common.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Represents a successful decoding state of a codepoint. */
 #define UNICODE_UTF8_STATE_ACCEPT ((u32) 0)
 
@@ -21,6 +25,46 @@
 /** The unicode replacement character in its UTF-8 encoded form. */
 extern u8 unicode_utf8_replacement_character[3];
 
+/** The result of the UTF-8 routines if the byte sequence is malformed. */
+#define UNICODE_UTF8_MALFORMED ((u64) -1)
+
+/** The result of the UTF-8 routines if the byte sequence is incomplete. */
+#define UNICODE_UTF8_INCOMPLETE ((u64) -2)
+
+/** The result of 'unicode_utf8_narrow' if a codepoint is greater than 255. */
+#define UNICODE_UTF8_WIDE ((u64) -3)
+
+/**
+ * An enumeration of the instruction set extensions which may be used by the 
+ * bulk UTF-8 routines.
+ */
+typedef enum {
+    /** Indicates the portable implementation which processes eight bytes at a time. */
+    UnicodeScalarInstructions = 0,
+    /** Indicates the implementation which uses SSE4.2 instructions. */
+    UnicodeSse42Instructions  = 1,
+    /** Indicates the implementation which uses AVX2 instructions. */
+    UnicodeAvx2Instructions   = 2
+} UnicodeInstructions;
+
+/**
+ * Returns the instruction set extensions which are currently used by the bulk 
+ * UTF-8 routines. 
+ * Initially, this is the best implementation that is supported by the CPU as 
+ * detected at runtime.
+ * @return UnicodeInstructions The instruction set extensions in use.
+ */
+UnicodeInstructions unicode_instructions(void);
+
+/**
+ * Selects the instruction set extensions which should be used by the bulk UTF-8
+ * routines. This is mostly useful to test the fallback implementations.
+ * @param instructions The requested instruction set extensions.
+ * @return bool Whether or not the CPU supports the requested instruction set extensions. If
+ * this is not the case, the selection remains unchanged.
+ */
+bool unicode_select_instructions(UnicodeInstructions instructions);
+
 /**
  * Decodes a unicode codepoint using the provided byte.
  * @param state A pointer to the current state of the decoding (initially this should be 'UNICODE_UTF8_STATE_ACCEPT')
@@ -42,15 +86,73 @@ u32 unicode_utf8_decode(u32 *state, u32 *codepoint, u32 byte);
  */
 u64 unicode_utf8_encode(u32 codepoint, u8 *bytes);
 
+/**
+ * Computes the exact number of bytes which are required to encode the provided codepoints using UTF-8.
+ * Codepoints which cannot be represented with UTF-8 are accounted for as the unicode replacement character.
+ * @param codepoints The codepoints of the unicode string.
+ * @param length The number of codepoints.
+ * @return u64 The number of bytes of the UTF-8 encoded string.
+ */
+u64 unicode_utf8_length(u32 *codepoints, u64 length);
+
+/**
+ * Encodes all of the provided codepoints using UTF-8 and stores the bytes at the provided memory location.
+ * Runs of ASCII characters as well as runs of codepoints with an equal encoded length are encoded using 
+ * vectorized instructions (see 'unicode_instructions'). Codepoints which cannot be represented with UTF-8 
+ * are replaced by the unicode replacement character.
+ * @param codepoints The codepoints of the unicode string.
+ * @param length The number of codepoints.
+ * @param bytes The memory location, which must be able to hold at least 'unicode_utf8_length(codepoints, length)'
+ * bytes.
+ * @return u64 The number of bytes which were written to the memory location.
+ */
+u64 unicode_utf8_encode_all(u32 *codepoints, u64 length, u8 *bytes);
+
 /**
  * Counts the number of unicode codepoints in the provided UTF-8 encoded byte-sequence.
+ * The byte sequence is validated using vectorized instructions (see 'unicode_instructions').
  * @param bytes The UTF-8 encoded byte sequence.
  * @param length The length of the byte sequence in number of bytes.
- * @return u64 The number of unicode codepoints, (u64) -1 if the byte sequence is malformed or (u64) -2 if the
- * UTF-8 byte sequence is incomplete.
+ * @return u64 The number of unicode codepoints, 'UNICODE_UTF8_MALFORMED' if the byte sequence is malformed or
+ * 'UNICODE_UTF8_INCOMPLETE' if the UTF-8 byte sequence is incomplete.
  */
 u64 unicode_utf8_count(u8 *bytes, u64 length);
 
+/**
+ * Counts the number of leading bytes of the provided byte sequence which are ASCII characters.
+ * @param bytes The byte sequence.
+ * @param length The length of the byte sequence in number of bytes.
+ * @return u64 The number of leading ASCII characters, which equals 'length' if all bytes are ASCII characters.
+ */
+u64 unicode_ascii_prefix(u8 *bytes, u64 length);
+
+/**
+ * Validates the provided UTF-8 encoded byte sequence and decodes it into the provided memory location.
+ * Leading runs of ASCII characters are widened without decoding them.
+ * @param bytes The UTF-8 encoded byte sequence.
+ * @param length The length of the byte sequence in number of bytes.
+ * @param codepoints The memory location where the codepoints should be stored. It must be able to hold at least
+ * 'length' codepoints.
+ * @return u64 The number of decoded codepoints, 'UNICODE_UTF8_MALFORMED' if the byte sequence is malformed or 
+ * 'UNICODE_UTF8_INCOMPLETE' if the UTF-8 byte sequence is incomplete. In case of an error, the contents of the
+ * memory location are unspecified.
+ */
+u64 unicode_utf8_transcode(u8 *bytes, u64 length, u32 *codepoints);
+
+/**
+ * Validates the provided UTF-8 encoded byte sequence and decodes it into one byte per codepoint (i.e. Latin-1).
+ * Runs of ASCII characters are copied and two-byte sequences of the codepoints U+0080 to U+00FF are narrowed
+ * using vectorized instructions (see 'unicode_instructions').
+ * @param bytes The UTF-8 encoded byte sequence.
+ * @param length The length of the byte sequence in number of bytes.
+ * @param codepoints The memory location where the codepoints should be stored. It must be able to hold at least
+ * 'length' bytes.
+ * @return u64 The number of decoded codepoints, 'UNICODE_UTF8_MALFORMED' if the byte sequence is malformed, 
+ * 'UNICODE_UTF8_INCOMPLETE' if the UTF-8 byte sequence is incomplete or 'UNICODE_UTF8_WIDE' if any codepoint
+ * is greater than 255. In case of an error, the contents of the memory location are unspecified.
+ */
+u64 unicode_utf8_narrow(u8 *bytes, u64 length, u8 *codepoints);
+
 /**
  * Checks whether the provided codepoint is a space character. 
  * @param codepoint The codepoint to check.
@@ -100,10 +202,16 @@ u32 *unicode_from_string(char *string);
 
 /**
  * Converts the provided unicode string to a null-terminated C string using UTF-8.
+ * The memory is allocated exactly once on basis of 'unicode_utf8_length' and filled using 
+ * 'unicode_utf8_encode_all'.
  * @param codepoints The codepoints of the unicode string.
  * @param length The number of codepoints.
  * @return char* The null-terminated C string.
  */
 char *unicode_to_string(u32 *codepoints, u64 length);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file